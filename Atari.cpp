@@ -455,12 +455,19 @@ extern "C"
   {
     //LUDO:
     ATARI.atari_snd_enable = 1;
+    ATARI.atari_snd_quality = ATARI_SND_QUALITY_FAST;
+    ATARI.atari_snd_width = 0;
     ATARI.atari_render_mode = ATARI_RENDER_NORMAL;
+    ATARI.atari_video_thread = 0;
     ATARI.atari_flicker_mode = ATARI_FLICKER_NONE;
+    ATARI.atari_flicker_blend = ATARI_DEF_FLICKER_BLEND;
     ATARI.atari_speed_limiter = 60;
+    ATARI.atari_sync_audio = ATARI_SYNC_TIMER;
     ATARI.psp_cpu_clock = GP2X_DEF_EMU_CLOCK;
     ATARI.psp_screenshot_id = 0;
     ATARI.atari_view_fps = 0;
+    ATARI.atari_run_ahead = 0;
+    ATARI.atari_rewind = 0;
 
     myPowerSetClockFrequency(ATARI.psp_cpu_clock);
   }
@@ -477,11 +484,18 @@ extern "C"
 
       fprintf(FileDesc, "psp_cpu_clock=%d\n", ATARI.psp_cpu_clock);
       fprintf(FileDesc, "psp_skip_max_frame=%d\n", ATARI.psp_skip_max_frame);
+      fprintf(FileDesc, "atari_run_ahead=%d\n", ATARI.atari_run_ahead);
+      fprintf(FileDesc, "atari_rewind=%d\n", ATARI.atari_rewind);
       fprintf(FileDesc, "atari_view_fps=%d\n", ATARI.atari_view_fps);
       fprintf(FileDesc, "atari_snd_enable=%d\n", ATARI.atari_snd_enable);
+      fprintf(FileDesc, "atari_snd_quality=%d\n", ATARI.atari_snd_quality);
+      fprintf(FileDesc, "atari_snd_width=%d\n", ATARI.atari_snd_width);
       fprintf(FileDesc, "atari_render_mode=%d\n", ATARI.atari_render_mode);
+      fprintf(FileDesc, "atari_video_thread=%d\n", ATARI.atari_video_thread);
       fprintf(FileDesc, "atari_flicker_mode=%d\n", ATARI.atari_flicker_mode);
+      fprintf(FileDesc, "atari_flicker_blend=%d\n", ATARI.atari_flicker_blend);
       fprintf(FileDesc, "atari_speed_limiter=%d\n", ATARI.atari_speed_limiter);
+      fprintf(FileDesc, "atari_sync_audio=%d\n", ATARI.atari_sync_audio);
 
       fclose(FileDesc);
     }
@@ -544,14 +558,28 @@ extern "C"
         ATARI.atari_view_fps = Value;
       else if (!strcasecmp(Buffer, "psp_skip_max_frame"))
         ATARI.psp_skip_max_frame = Value;
+      else if (!strcasecmp(Buffer, "atari_run_ahead"))
+        ATARI.atari_run_ahead = Value;
+      else if (!strcasecmp(Buffer, "atari_rewind"))
+        ATARI.atari_rewind = Value;
       else if (!strcasecmp(Buffer, "atari_snd_enable"))
         ATARI.atari_snd_enable = Value;
+      else if (!strcasecmp(Buffer, "atari_snd_quality"))
+        ATARI.atari_snd_quality = Value;
+      else if (!strcasecmp(Buffer, "atari_snd_width"))
+        ATARI.atari_snd_width = Value;
       else if (!strcasecmp(Buffer, "atari_render_mode"))
         ATARI.atari_render_mode = Value;
+      else if (!strcasecmp(Buffer, "atari_video_thread"))
+        ATARI.atari_video_thread = Value;
       else if (!strcasecmp(Buffer, "atari_flicker_mode"))
         ATARI.atari_flicker_mode = Value;
+      else if (!strcasecmp(Buffer, "atari_flicker_blend"))
+        ATARI.atari_flicker_blend = Value;
       else if (!strcasecmp(Buffer, "atari_speed_limiter"))
         ATARI.atari_speed_limiter = Value;
+      else if (!strcasecmp(Buffer, "atari_sync_audio"))
+        ATARI.atari_sync_audio = Value;
     }
 
     fclose(FileDesc);
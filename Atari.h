@@ -6,8 +6,10 @@ extern "C" {
 # endif
 
 //LUDO:
-# define ATARI_RENDER_NORMAL   0
-# define ATARI_LAST_RENDER     0
+# define ATARI_RENDER_NORMAL     0
+# define ATARI_RENDER_HW_SHARP   1
+# define ATARI_RENDER_HW_SMOOTH  2
+# define ATARI_LAST_RENDER       2
 
 # define ATARI_FLICKER_NONE      0
 # define ATARI_FLICKER_SIMPLE    1
@@ -15,11 +17,27 @@ extern "C" {
 # define ATARI_FLICKER_PHOSPHOR  3
 # define ATARI_LAST_FLICKER      3
 
+# define ATARI_DEF_FLICKER_BLEND 77
+
+# define ATARI_MAX_RUN_AHEAD     2
+
+# define ATARI_SND_QUALITY_FAST  0
+# define ATARI_SND_QUALITY_HIGH  1
+
+# define ATARI_SYNC_TIMER        0
+# define ATARI_SYNC_SOUND        1
+# define ATARI_SYNC_RESAMPLE     2
+# define ATARI_LAST_SYNC         2
+
 # define MAX_PATH           256
 # define ATARI_MAX_SAVE_STATE 5
 # define ATARI_MAX_CHEAT        10
 
+#ifndef HEADLESS
 #include <SDL/SDL.h>
+#else
+#include "HeadlessSDL.h"
+#endif
 
 #define ATARI_CHEAT_NONE    0
 #define ATARI_CHEAT_ENABLE  1
@@ -60,13 +78,22 @@ extern "C" {
     int  atari_current_clock;
     int  atari_view_fps;
     int  atari_current_fps;
+    int  atari_current_jitter;
     int  psp_active_joystick;
     int  atari_flicker_mode;
+    int  atari_flicker_blend;
     int  atari_snd_enable;
+    int  atari_snd_quality;
+    int  atari_snd_width;
     int  atari_render_mode;
+    int  atari_video_thread;
     int  atari_speed_limiter;
+    int  atari_sync_audio;
     int  psp_skip_max_frame;
     int  psp_skip_cur_frame;
+    int  atari_run_ahead;
+    int  atari_rewind;
+    int  atari_rewind_pressed;
     int  atari_slow_down_max;
     int  atari_paddle_enable;
     int  atari_paddle_speed;
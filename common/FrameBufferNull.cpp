@@ -0,0 +1,46 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "bspf.hxx"
+
+#include "FrameBuffer.hxx"
+#include "FrameBufferNull.hxx"
+#include "OSystem.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameBufferNull::FrameBufferNull(OSystem* osystem)
+  : FrameBuffer(osystem)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameBufferNull::~FrameBufferNull()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBufferNull::createScreen()
+{
+  // There is no screen; just remember the dimensions we were asked for
+  myScreenDim.x = myScreenDim.y = 0;
+  myScreenDim.w = myBaseDim.w;
+  myScreenDim.h = myBaseDim.h;
+  myImageDim = myScreenDim;
+
+  return true;
+}
@@ -0,0 +1,83 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef FRAMEBUFFER_NULL_HXX
+#define FRAMEBUFFER_NULL_HXX
+
+#ifndef HEADLESS
+#include <SDL/SDL.h>
+#else
+#include "HeadlessSDL.h"
+#endif
+
+class OSystem;
+
+#include "bspf.hxx"
+#include "FrameBuffer.hxx"
+
+/**
+  This class implements a Null framebuffer, where-by nothing is ever
+  drawn.  The TIA still renders into its own frame buffers, so this is
+  used by the headless benchmark to measure the emulation core alone.
+
+  Colors are mapped to RGB565, the same format as the handheld surface,
+  so the palette tables built by FrameBuffer::setPalette() are identical.
+*/
+class FrameBufferNull : public FrameBuffer
+{
+  public:
+    /**
+      Creates a new null framebuffer
+    */
+    FrameBufferNull(OSystem* osystem);
+
+    /**
+      Destructor
+    */
+    virtual ~FrameBufferNull();
+
+    //////////////////////////////////////////////////////////////////////
+    // The following methods are derived from FrameBuffer.hxx
+    //////////////////////////////////////////////////////////////////////
+    virtual bool initVideoSystem() { return true; }
+    virtual bool initSubsystem() { return createScreen(); }
+    virtual BufferType type() { return kSoftBuffer; }
+    virtual void setAspectRatio() { theAspectRatio = 1.0; }
+    virtual bool createScreen();
+    virtual void toggleFilter() { }
+    virtual void drawMediaSourceNormal() { }
+    virtual void drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer) { }
+    virtual void showFrame() { }
+    virtual void preFrameUpdate() { }
+    virtual void postFrameUpdate() { }
+    virtual void scanline(uInt32 row, uInt8* data) { }
+    virtual Uint32 mapRGB(Uint8 r, Uint8 g, Uint8 b)
+      { return ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3); }
+    virtual void hLine(uInt32 x, uInt32 y, uInt32 x2, int color) { }
+    virtual void vLine(uInt32 x, uInt32 y, uInt32 y2, int color) { }
+    virtual void fillRect(uInt32 x, uInt32 y, uInt32 w, uInt32 h,
+                          int color) { }
+    virtual void drawBitmap(uInt32* bitmap, Int32 x, Int32 y, int color,
+                            Int32 h = 8) { }
+    virtual void translateCoords(Int32* x, Int32* y) { }
+    virtual void addDirtyRect(uInt32 x, uInt32 y, uInt32 w, uInt32 h) { }
+    virtual void enablePhosphor(bool enable) { myUsePhosphor = enable; }
+    virtual void cls() { }
+};
+
+#endif
@@ -17,10 +17,12 @@
 //============================================================================
 
 #include <SDL/SDL.h>
+#include <string.h>
 #include <sstream>
 
 #include "Atari.h"
 #include "psp_sdl.h"
+#include "psp_kbd.h"
 
 #include "Console.hxx"
 #include "FrameBuffer.hxx"
@@ -33,20 +35,72 @@
 # endif
 #include "GuiUtils.hxx"
 
+// Height of the fps counter printed at the top of the screen
+#define FRAMEBUFFER_FPS_HEIGHT  10
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBufferSoft::FrameBufferSoft(OSystem* osystem)
   : FrameBuffer(osystem),
     myRectList(NULL),
     myOverlayRectList(NULL),
+    myShownFrame(NULL),
+    myShownPreviousFrame(NULL),
+    myShownWidth(0),
+    myShownHeight(0),
+    myShownFlicker(false),
+    myShownBuffer(NULL),
+    myShownPitch(PSP_LINE_SIZE),
+    myShownScaled(false),
+    myShownFps(false),
+    myDirtyLines(NULL),
+    myFrameStreamed(false),
+    myFullFlip(true),
+    myPresenter(NULL),
+    myPresenterSem(NULL),
+    myPresenterQuit(false),
+    myFrameHandedOver(false),
     myRenderType(kSoftZoom)
 {
+  for(uInt32 i = 0; i < 3; ++i)
+  {
+    myPresentedData[i] = NULL;
+    myPresentedSize[i] = 0;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBufferSoft::~FrameBufferSoft()
 {
+  stopPresenter();
+
   delete myRectList;
   delete myOverlayRectList;
+  delete[] myShownFrame;
+  delete[] myShownPreviousFrame;
+  delete[] myDirtyLines;
+
+  if(myPresenterSem)
+    SDL_DestroySemaphore(myPresenterSem);
+  for(uInt32 i = 0; i < 3; ++i)
+    delete[] myPresentedData[i];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBufferSoft::initVideoSystem()
+{
+  if(!(SDL_WasInit(SDL_INIT_VIDEO) & SDL_INIT_VIDEO))
+  {
+    Uint32 initflags = SDL_INIT_VIDEO | SDL_INIT_TIMER;
+
+    if(SDL_Init(initflags) < 0)
+      return false;
+  }
+
+  // Enable unicode so we can see translated key events
+  // (lowercase vs. uppercase characters)
+  SDL_EnableUNICODE(1);
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -364,41 +418,137 @@ render16bpp_X125_pixelAvg(word *dist, const byte *b_src, const byte *b_prev, Uin
   dist[9] = dist[8];
 }
 
+/*
+  Doubles a line of pixels, writing both copies of a pixel at once from
+  a table of doubled colours; dist must be 32-bit aligned.
+ */
+static inline void
+render16bpp_doubledLine(dword *dist, const byte *b_src, const uInt32* my_doubled,
+                        uInt32 width)
+{
+  uInt32 x = 0;
 
+  for(; x + 4 <= width; x += 4)
+  {
+    dword d0 = my_doubled[b_src[x]];
+    dword d1 = my_doubled[b_src[x+1]];
+    dword d2 = my_doubled[b_src[x+2]];
+    dword d3 = my_doubled[b_src[x+3]];
+
+    dist[x]   = d0;
+    dist[x+1] = d1;
+    dist[x+2] = d2;
+    dist[x+3] = d3;
+  }
+  for(; x < width; ++x)
+    dist[x] = my_doubled[b_src[x]];
+}
+
+/*
+  Same for the flicker modes, from a table of the doubled colour of each
+  pair of current and previous frame pixels.
+ */
+static inline void
+render16bpp_flickerLine(dword *dist, const byte *b_src, const byte *b_prev,
+                        const uInt32 (*my_flicker)[256], uInt32 width)
+{
+  uInt32 x = 0;
+
+  for(; x + 4 <= width; x += 4)
+  {
+    dword d0 = my_flicker[b_src[x]][b_prev[x]];
+    dword d1 = my_flicker[b_src[x+1]][b_prev[x+1]];
+    dword d2 = my_flicker[b_src[x+2]][b_prev[x+2]];
+    dword d3 = my_flicker[b_src[x+3]][b_prev[x+3]];
+
+    dist[x]   = d0;
+    dist[x+1] = d1;
+    dist[x+2] = d2;
+    dist[x+3] = d3;
+  }
+  for(; x < width; ++x)
+    dist[x] = my_flicker[b_src[x]][b_prev[x]];
+}
+
+/*
+  Converts a line of pixels without doubling them, the hardware scaler
+  does it.
+ */
+static inline void
+render16bpp_line(word *dist, const byte *b_src, const Uint32* my_palette,
+                 uInt32 width)
+{
+  uInt32 x = 0;
+
+  for(; x + 4 <= width; x += 4)
+  {
+    word d0 = my_palette[b_src[x]];
+    word d1 = my_palette[b_src[x+1]];
+    word d2 = my_palette[b_src[x+2]];
+    word d3 = my_palette[b_src[x+3]];
+
+    dist[x]   = d0;
+    dist[x+1] = d1;
+    dist[x+2] = d2;
+    dist[x+3] = d3;
+  }
+  for(; x < width; ++x)
+    dist[x] = my_palette[b_src[x]];
+}
+
+/*
+  Same for the flicker modes; both halves of a doubled colour are the
+  same, the low one is taken.
+ */
+static inline void
+render16bpp_flickerScaledLine(word *dist, const byte *b_src, const byte *b_prev,
+                              const uInt32 (*my_flicker)[256], uInt32 width)
+{
+  uInt32 x;
+
+  for(x = 0; x < width; ++x)
+    dist[x] = (word)my_flicker[b_src[x]][b_prev[x]];
+}
 
 void
 FrameBufferSoft::drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer)
 {
-  MediaSource& mediasrc = myOSystem->console().mediaSource();
-  uInt8* currentFrame   = mediasrc.currentFrameBuffer();
-  uInt8* previousFrame  = mediasrc.previousFrameBuffer();
+  FrameSource frame = mediaSourceFrame();
 
-  /* w 160 x h 210 */
-  uInt32 width  = mediasrc.width();
-  uInt32 height = mediasrc.height();
+  drawMediaSourceLines(frame, pitch, buffer, 0, frame.height);
+}
 
-  uInt32 y;
+void
+FrameBufferSoft::drawMediaSourceLines(const FrameSource& frame, uInt32 pitch,
+                                      uInt16* buffer, uInt32 first, uInt32 last)
+{
+  const uInt8* currentFrame  = frame.current;
+  const uInt8* previousFrame = frame.previous;
 
-  if (ATARI.atari_flicker_mode && previousFrame) {
+  /* w 160 x h 210 */
+  uInt32 width  = frame.width;
 
-    for(y = 0; y < height; ++y )
-    {
-      const uInt32 bufofsY    = y * width;
-      const uInt32 screenofsY = y * pitch;
+  /* Every line starts on a 32-bit boundary */
+  bool aligned = !(((unsigned long)buffer | (pitch << 1)) & 3);
 
-      if (ATARI.atari_flicker_mode == ATARI_FLICKER_PHOSPHOR) {
+  uInt32 y;
 
-        uInt32 x;
-        for(x = 0; x < width; ++x )
-        {
-          const uInt32 off = screenofsY + (x << 1);
-          byte v = currentFrame[bufofsY + x];
-          byte w = previousFrame[bufofsY + x];
-          buffer[off] = buffer[off+1] = myAvgPalette[v][w];
-        }
+  if (previousFrame) {
 
-      } else
-      if (ATARI.atari_flicker_mode == ATARI_FLICKER_AVERAGE) {
+    /* The table was built by setPalette for the current mode */
+    if (aligned) {
+      for(y = first; y < last; ++y )
+      {
+        render16bpp_flickerLine((dword*)(buffer + y * pitch),
+                                currentFrame + y * width,
+                                previousFrame + y * width,
+                                myFlickerPalette, width);
+      }
+    } else {
+      for(y = first; y < last; ++y )
+      {
+        const uInt32 bufofsY    = y * width;
+        const uInt32 screenofsY = y * pitch;
 
         uInt32 x;
         for(x = 0; x < width; ++x )
@@ -406,25 +556,24 @@ FrameBufferSoft::drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer)
           const uInt32 off = screenofsY + (x << 1);
           byte v = currentFrame[bufofsY + x];
           byte w = previousFrame[bufofsY + x];
-          buffer[off] = buffer[off+1] = loc_coloraverage(myDefPalette[v], myDefPalette[w]);
-        }
-      } else { /* Simple */
-
-        uInt32 x;
-        for(x = 0; x < width; ++x )
-        {
-          const uInt32 off = screenofsY + (x << 1);
-          byte color = currentFrame[bufofsY + x];
-          if (! color) color = previousFrame[bufofsY + x];
-          buffer[off] = buffer[off+1] = myDefPalette[color];
+          buffer[off] = buffer[off+1] = myFlickerPalette[v][w];
         }
       }
+    }
 
+  } else
+  if (aligned) {
+
+    for(y = first; y < last; ++y )
+    {
+      render16bpp_doubledLine((dword*)(buffer + y * pitch),
+                              currentFrame + y * width,
+                              myDoubledPalette, width);
     }
 
   } else {
 
-    for(y = 0; y < height; ++y )
+    for(y = first; y < last; ++y )
     {
       const uInt32 bufofsY    = y * width;
       const uInt32 screenofsY = y * pitch;
@@ -441,30 +590,386 @@ FrameBufferSoft::drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer)
 
 }
 
+void
+FrameBufferSoft::drawMediaSourceScaledLines(const FrameSource& frame,
+                                            uInt32 pitch, uInt16* buffer,
+                                            uInt32 first, uInt32 last)
+{
+  const uInt8* currentFrame  = frame.current;
+  const uInt8* previousFrame = frame.previous;
+
+  uInt32 width  = frame.width;
+
+  uInt32 y;
+
+  if (previousFrame) {
+    for(y = first; y < last; ++y )
+    {
+      render16bpp_flickerScaledLine(buffer + y * pitch,
+                                    currentFrame + y * width,
+                                    previousFrame + y * width,
+                                    myFlickerPalette, width);
+    }
+  } else {
+    for(y = first; y < last; ++y )
+    {
+      render16bpp_line(buffer + y * pitch, currentFrame + y * width,
+                       myDefPalette, width);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::drawShownLines(const FrameSource& frame,
+                                     uInt32 first, uInt32 last)
+{
+  if (myShownScaled)
+    drawMediaSourceScaledLines(frame, myShownPitch, myShownBuffer, first, last);
+  else
+    drawMediaSourceLines(frame, myShownPitch, myShownBuffer, first, last);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBufferSoft::updateShownLine(const FrameSource& frame, uInt32 line)
+{
+  const uInt32 offset = line * myShownWidth;
+
+  const uInt8* current = frame.current + offset;
+  bool changed = memcmp(myShownFrame + offset, current, myShownWidth) != 0;
+  if (changed)
+    memcpy(myShownFrame + offset, current, myShownWidth);
+
+  /* The flicker modes also show the previous frame */
+  if (frame.previous) {
+    const uInt8* previous = frame.previous + offset;
+    if (memcmp(myShownPreviousFrame + offset, previous, myShownWidth)) {
+      memcpy(myShownPreviousFrame + offset, previous, myShownWidth);
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameBufferSoft::FrameSource FrameBufferSoft::mediaSourceFrame()
+{
+  MediaSource& mediasrc = myOSystem->console().mediaSource();
+
+  FrameSource frame;
+  frame.current  = mediasrc.currentFrameBuffer();
+  frame.previous = ATARI.atari_flicker_mode ? mediasrc.previousFrameBuffer() : 0;
+  frame.width    = mediasrc.width();
+  frame.height   = mediasrc.height();
+  frame.scaled   = NULL;
+  frame.fps[0]   = '\0';
+
+  return frame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SDL_Surface* FrameBufferSoft::selectVideoMode()
+{
+  /* The hardware scaler doubles the pixels instead, unless something
+     has to be drawn over the game at the full resolution */
+  bool scaled = (ATARI.atari_render_mode != ATARI_RENDER_NORMAL) &&
+                !ATARI.atari_view_fps && !psp_kbd_is_danzeff_mode() &&
+                !psp_screenshot_mode;
+
+  /* The video thread may be drawing to the surfaces the video mode
+     replaces, so it has to be done with the screen first */
+  if (scaled ? (!psp_sdl_is_scaled() && psp_sdl_can_scale())
+             : psp_sdl_is_scaled())
+    psp_sdl_acquire_screen();
+
+  SDL_Surface* surface = NULL;
+  if (scaled) {
+    surface = psp_sdl_enter_scaled(
+                  ATARI.atari_render_mode == ATARI_RENDER_HW_SMOOTH);
+  }
+  if (!surface) {
+    psp_sdl_leave_scaled();
+  }
+
+  return surface;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //LUDO:
 void 
 FrameBufferSoft::drawMediaSourceNormal()
 {
-  MediaSource& mediasrc = myOSystem->console().mediaSource();
-  uInt8* currentFrame   = mediasrc.currentFrameBuffer();
-  uInt8* previousFrame  = mediasrc.previousFrameBuffer();
+  // The video thread is started and stopped from the settings menu
+  if (ATARI.atari_video_thread && !myPresenter)
+    startPresenter();
+  else if (!ATARI.atari_video_thread && myPresenter)
+    stopPresenter();
+
+  /* The virtual keyboard can only be drawn by this thread, and so is the
+     game under it */
+  myFrameHandedOver = myPresenter && !psp_kbd_is_danzeff_mode();
+  if (!myFrameHandedOver)
+    psp_sdl_acquire_screen();
+
+  FrameSource frame = mediaSourceFrame();
+  frame.scaled = selectVideoMode();
+  if (ATARI.atari_view_fps)
+    formatFps(frame.fps);
+
+  if (myFrameHandedOver)
+    copyFrame(frame);
+  else
+    drawFrame(frame);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::drawFrame(const FrameSource& frame)
+{
+  uInt32 width  = frame.width;
+  uInt32 height = frame.height;
 
-  uInt32 pitch = 0;
-  uInt16* buffer;
+  /* The video mode was chosen with the frame */
+  SDL_Surface* scaled = frame.scaled;
 
-  uInt32 width  = mediasrc.width() * 2;
-  uInt32 height = mediasrc.height();
+  int pixel_width = scaled ? width : width * 2;
+  int screen_width = scaled ? PSP_SDL_SCALED_WIDTH : PSP_SDL_SCREEN_WIDTH;
 
-  int delta_x = (PSP_SDL_SCREEN_WIDTH -  width) / 2;
+  int delta_x = (screen_width -  pixel_width) / 2;
   int delta_y = (PSP_SDL_SCREEN_HEIGHT - height) / 2;
   if (delta_x < 0) delta_x = 0;
   if (delta_y < 0) delta_y = 0;
 
-  buffer = (uInt16*)psp_sdl_get_vram_addr(delta_x, delta_y);
-  pitch  = PSP_LINE_SIZE;
+  if (scaled) {
+    myShownPitch  = scaled->pitch / 2;
+    myShownBuffer = (uInt16*)scaled->pixels + delta_x + delta_y * myShownPitch;
+  } else {
+    myShownPitch  = PSP_LINE_SIZE;
+    myShownBuffer = (uInt16*)psp_sdl_get_vram_addr(delta_x, delta_y);
+  }
+  myShownScaled = (scaled != NULL);
+  myShownFps = (frame.fps[0] != '\0');
+
+  bool flicker = (frame.previous != 0);
+
+  /* Anything else drawn on the screen, or a new palette, means that
+     every line has to be drawn again */
+  bool full = psp_sdl_full_update || theRedrawTIAIndicator ||
+              (flicker != myShownFlicker) ||
+              (width != myShownWidth) || (height != myShownHeight);
+
+  if (width * height != myShownWidth * myShownHeight) {
+    delete[] myShownFrame;
+    delete[] myShownPreviousFrame;
+    myShownFrame         = new uInt8[width * height];
+    myShownPreviousFrame = new uInt8[width * height];
+  }
+  if (height != myShownHeight) {
+    delete[] myDirtyLines;
+    myDirtyLines = new bool[height];
+    memset(myDirtyLines, 0, height * sizeof(bool));
+  }
+  myShownWidth  = width;
+  myShownHeight = height;
+  myShownFlicker = flicker;
+
+  /* Unless the lines were already drawn while the frame was emulated */
+  if (full || !myFrameStreamed) {
 
-  drawMediaSourceBlitSurface(pitch, buffer);
+    uInt32 y = 0;
+    while (y < height) {
+
+      /* Find the next span of lines that changed */
+      if (!updateShownLine(frame, y) && !full) {
+        ++y;
+        continue;
+      }
+
+      uInt32 first = y;
+      myDirtyLines[y++] = true;
+      while (y < height && (updateShownLine(frame, y) || full))
+        myDirtyLines[y++] = true;
+
+      drawShownLines(frame, first, y);
+    }
+  }
+
+  /* Only the lines that changed are flipped */
+  myRectList->start();
+
+  SDL_Rect rect;
+  rect.x = delta_x;
+  rect.w = pixel_width;
+
+  uInt32 y = 0;
+  while (y < height) {
+
+    if (!myDirtyLines[y]) {
+      ++y;
+      continue;
+    }
+
+    uInt32 first = y;
+    while (y < height && myDirtyLines[y])
+      myDirtyLines[y++] = false;
+
+    rect.y = delta_y + first;
+    rect.h = y - first;
+    myRectList->add(&rect);
+  }
+
+  myFrameStreamed = false;
+  myFullFlip = full;
+
+  psp_sdl_full_update  = 0;
+  theRedrawTIAIndicator = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScanlineListener* FrameBufferSoft::scanlineListener()
+{
+  // The video thread draws whole frames, the screen isn't ours
+  return myPresenter ? 0 : this;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::scanlineDrawn(uInt32 line)
+{
+  FrameSource frame = mediaSourceFrame();
+
+  /* If the screen changed since the last frame was drawn, the next one
+     is drawn all at once; a menu may even have changed the video mode,
+     so the shown buffer can't be written */
+  bool flicker = (frame.previous != 0);
+  if (psp_sdl_full_update || !myShownBuffer || (line >= myShownHeight) ||
+      (frame.width != myShownWidth) ||
+      (frame.height != myShownHeight) || (flicker != myShownFlicker))
+    return;
+
+  if (updateShownLine(frame, line)) {
+    drawShownLines(frame, line, line + 1);
+    myDirtyLines[line] = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::frameDrawn(uInt32 lines)
+{
+  // The lines the frame didn't reach are shown as they are
+  for (uInt32 line = lines; line < myShownHeight; ++line)
+    scanlineDrawn(line);
+
+  myFrameStreamed = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::showFrame()
+{
+  if (!myFrameHandedOver)
+  {
+    FrameBuffer::showFrame();
+    return;
+  }
+
+  // The screen is the video thread's again, until a menu takes it back
+  myPresentedFrames.publish();
+  psp_sdl_release_screen();
+  SDL_SemPost(myPresenterSem);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::copyFrame(const FrameSource& source)
+{
+  uInt32 slot = myPresentedFrames.back();
+  uInt32 size = source.width * source.height;
+  uInt32 needed = source.previous ? size * 2 : size;
+
+  // Only the video thread's frames are in use, this one is ours
+  if (needed > myPresentedSize[slot])
+  {
+    delete[] myPresentedData[slot];
+    myPresentedData[slot] = new uInt8[needed];
+    myPresentedSize[slot] = needed;
+  }
+
+  FrameSource& frame = myPresentedFrame[slot];
+  frame = source;
+  frame.current = myPresentedData[slot];
+  memcpy(myPresentedData[slot], source.current, size);
+  if (source.previous)
+  {
+    frame.previous = myPresentedData[slot] + size;
+    memcpy(myPresentedData[slot] + size, source.previous, size);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::startPresenter()
+{
+  if (!myPresenterSem)
+    myPresenterSem = SDL_CreateSemaphore(0);
+
+  myPresenterQuit = false;
+  myPresenter = myPresenterSem ? SDL_CreateThread(presenterThread, this) : 0;
+  if (!myPresenter)
+  {
+    cerr << "WARNING: Couldn't start the video thread" << endl;
+    ATARI.atari_video_thread = 0;
+    return;
+  }
+
+  // Whatever the screen shows, the first frame replaces it all
+  psp_sdl_full_update = 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::stopPresenter()
+{
+  if (!myPresenter)
+    return;
+
+  // It may be waiting for the screen
+  psp_sdl_release_screen();
+
+  myPresenterQuit = true;
+  SDL_SemPost(myPresenterSem);
+  SDL_WaitThread(myPresenter, NULL);
+  myPresenter = 0;
+
+  // Drawing the next frames is ours again
+  psp_sdl_acquire_screen();
+  psp_sdl_full_update = 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int FrameBufferSoft::presenterThread(void* framebuffer)
+{
+  ((FrameBufferSoft*)framebuffer)->presenterLoop();
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferSoft::presenterLoop()
+{
+  for(;;)
+  {
+    SDL_SemWait(myPresenterSem);
+    if(myPresenterQuit)
+      break;
+
+    // Frames published while the last one was shown are skipped, only
+    // the newest one is.  Everything about how it's shown was decided
+    // when it was published.
+    psp_sdl_present_begin();
+    if(myPresentedFrames.update())
+    {
+      const FrameSource& frame = myPresentedFrame[myPresentedFrames.front()];
+      drawFrame(frame);
+      if(frame.fps[0] != '\0')
+        drawFps(frame.fps);
+      postFrameUpdate();
+    }
+    psp_sdl_present_end();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -496,6 +1001,29 @@ void FrameBufferSoft::postFrameUpdate()
     SDL_Flip(myScreen);
     myRectList->start();
   }
+# else
+  // Something was drawn over the screen before or after the frame,
+  // so it all has to go
+  if(myFullFlip || psp_sdl_full_update)
+  {
+    psp_sdl_flip_screen();
+    return;
+  }
+
+  // The fps counter is printed over the top of the screen (never
+  // through the scaler)
+  if(myShownFps && !myShownScaled)
+  {
+    SDL_Rect rect;
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = PSP_SDL_SCREEN_WIDTH;
+    rect.h = FRAMEBUFFER_FPS_HEIGHT;
+    myRectList->add(&rect);
+  }
+
+  if(myRectList->numRects() > 0)
+    psp_sdl_flip_rects(myRectList->rects(), myRectList->numRects());
 # endif
 }
 
@@ -30,6 +30,7 @@ class RectList;
 #include "bspf.hxx"
 #include "GuiUtils.hxx"
 #include "FrameBuffer.hxx"
+#include "TripleBuffer.hxx"
 
 
 /**
@@ -38,7 +39,7 @@ class RectList;
   @author  Stephen Anthony
   @version $Id: FrameBufferSoft.hxx,v 1.34 2006/03/25 00:34:17 stephena Exp $
 */
-class FrameBufferSoft : public FrameBuffer
+class FrameBufferSoft : public FrameBuffer, public ScanlineListener
 {
   public:
     /**
@@ -54,6 +55,11 @@ class FrameBufferSoft : public FrameBuffer
     //////////////////////////////////////////////////////////////////////
     // The following methods are derived from FrameBuffer.hxx
     //////////////////////////////////////////////////////////////////////
+    /**
+      This method is called to initialize the SDL video system.
+    */
+    virtual bool initVideoSystem();
+
     /**
       This method is called to initialize software video mode.
       Return false if any operation fails, otherwise return true.
@@ -93,6 +99,28 @@ class FrameBufferSoft : public FrameBuffer
     virtual void drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer);
 # endif
 
+    /**
+      Answers this framebuffer, which draws the scanlines of the media
+      source to the screen as soon as they're emulated (unless the video
+      thread draws the frames).
+    */
+    virtual ScanlineListener* scanlineListener();
+
+    /**
+      Shows the frame, or hands it to the video thread.
+    */
+    virtual void showFrame();
+
+    /**
+      Draws a scanline of the frame being emulated, if it changed.
+    */
+    virtual void scanlineDrawn(uInt32 line);
+
+    /**
+      Draws the scanlines the frame being emulated didn't reach.
+    */
+    virtual void frameDrawn(uInt32 lines);
+
     /**
       This method is called before any drawing is done (per-frame).
     */
@@ -216,9 +244,105 @@ class FrameBufferSoft : public FrameBuffer
     // Used in the dirty update of the overlay surface
     RectList* myOverlayRectList;
 
+  private:
+    // A frame to draw: the media source's, or a copy of it handed to the
+    // video thread.  The previous frame is only set for the flicker modes.
+    // How it's shown is decided by the main thread: the surface of the
+    // hardware scaler if it goes through it, and the fps counter printed
+    // over it by the video thread (empty if none).
+    struct FrameSource
+    {
+      const uInt8* current;
+      const uInt8* previous;
+      uInt32 width;
+      uInt32 height;
+      SDL_Surface* scaled;
+      char fps[FRAMEBUFFER_FPS_SIZE];
+    };
+
+    // Answers the frame of the media source
+    FrameSource mediaSourceFrame();
+
+    // Switches to the video mode the next frame is shown in, and answers
+    // the surface of the hardware scaler if it's used
+    SDL_Surface* selectVideoMode();
+
+    // Draws the lines of the frame which changed to the screen, and lists
+    // them to be flipped
+    void drawFrame(const FrameSource& frame);
+
+    // Converts the given lines of a frame into the surface
+    void drawMediaSourceLines(const FrameSource& frame, uInt32 pitch,
+                              uInt16* buffer, uInt32 first, uInt32 last);
+
+    // Same without doubling the pixels, for the hardware scaler
+    void drawMediaSourceScaledLines(const FrameSource& frame, uInt32 pitch,
+                                    uInt16* buffer, uInt32 first, uInt32 last);
+
+    // Converts the given lines of a frame to where it's shown
+    void drawShownLines(const FrameSource& frame, uInt32 first, uInt32 last);
+
+    // Answers whether a line differs from the one last drawn to the
+    // screen, and remembers it if so
+    bool updateShownLine(const FrameSource& frame, uInt32 line);
+
+    // Starts and stops the video thread
+    void startPresenter();
+    void stopPresenter();
+
+    // Copies the given frame for the video thread
+    void copyFrame(const FrameSource& source);
+
+    // The video thread, which draws and flips the frames handed to it
+    static int presenterThread(void* framebuffer);
+    void presenterLoop();
+
   private:
     int myPitch;
 
+    // The current (and for the flicker modes previous) frame lines last
+    // drawn to the screen, so that only the lines that changed are
+    // converted and flipped
+    uInt8* myShownFrame;
+    uInt8* myShownPreviousFrame;
+    uInt32 myShownWidth;
+    uInt32 myShownHeight;
+    bool myShownFlicker;
+
+    // Where the frame is shown on the screen, and whether it goes
+    // through the hardware scaler
+    uInt16* myShownBuffer;
+    uInt32 myShownPitch;
+    bool myShownScaled;
+
+    // Whether the fps counter is printed over the frame shown
+    bool myShownFps;
+
+    // The lines drawn since the screen was last flipped
+    bool* myDirtyLines;
+
+    // Whether the lines of the frame were drawn while it was emulated
+    bool myFrameStreamed;
+
+    // Whether the whole screen has to be flipped with the frame
+    bool myFullFlip;
+
+    // The video thread, and the semaphore posted for each frame handed
+    // to it
+    SDL_Thread* myPresenter;
+    SDL_sem* myPresenterSem;
+    volatile bool myPresenterQuit;
+
+    // Whether the frame being shown was handed to the video thread; the
+    // main thread draws the ones with the virtual keyboard itself
+    bool myFrameHandedOver;
+
+    // The frames handed to the video thread
+    TripleBuffer myPresentedFrames;
+    FrameSource myPresentedFrame[3];
+    uInt8* myPresentedData[3];
+    uInt32 myPresentedSize[3];
+
     enum RenderType {
       kSoftZoom,
       kPhosphor_16,
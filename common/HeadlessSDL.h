@@ -0,0 +1,54 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef HEADLESS_SDL_H
+#define HEADLESS_SDL_H
+
+/*
+  The few SDL types and constants the emulation core still names, for the
+  headless builds (-DHEADLESS) which have no SDL at all.  The surfaces,
+  joysticks and events are only ever passed around by pointer there, so
+  they're left incomplete.  The values are SDL 1.2's.
+*/
+
+#include <stdint.h>
+
+typedef uint8_t  Uint8;
+typedef uint16_t Uint16;
+typedef uint32_t Uint32;
+typedef int16_t  Sint16;
+
+typedef struct SDL_Rect {
+  Sint16 x, y;
+  Uint16 w, h;
+} SDL_Rect;
+
+typedef struct SDL_Surface SDL_Surface;
+typedef struct _SDL_Joystick SDL_Joystick;
+typedef union SDL_Event SDL_Event;
+
+#define SDL_FULLSCREEN  0x80000000
+
+#define SDLK_TAB        9
+#define SDLK_LAST       323
+
+#define KMOD_SHIFT      0x0003
+#define KMOD_CTRL       0x00C0
+#define KMOD_ALT        0x0300
+
+#endif
@@ -0,0 +1,213 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <iomanip>
+
+#include <time.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "bspf.hxx"
+#include "Console.hxx"
+#include "MediaSrc.hxx"
+#include "System.hxx"
+#include "OSystem.hxx"
+#include "SoundCapture.hxx"
+#include "OSystemBench.hxx"
+
+// NTSC 6502 clock: 3.579545 MHz colour clock divided by three
+#define BENCH_CPU_MHZ  1.193182
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+OSystemBench::OSystemBench()
+  : myNumberOfFrames(3000),
+    myWarmupFrames(60),
+    myRunAheadFrames(0),
+    mySkipFrames(0),
+    myTotalTime(0),
+    myRunAheadTime(0),
+    myMinFrameTime(0),
+    myMaxFrameTime(0),
+    myTotalCycles(0),
+    myFrameChecksum(0),
+    mySoundCapture(0),
+    mySoundRenderTime(0)
+{
+  char buffer[256];
+  if(getcwd(buffer, 256) == NULL)
+    buffer[0] = '\0';
+  setBaseDir(string(buffer));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+OSystemBench::~OSystemBench()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::setFrames(uInt32 frames, uInt32 warmup)
+{
+  myNumberOfFrames = frames;
+  myWarmupFrames = warmup;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::setRunAhead(uInt32 frames)
+{
+  myRunAheadFrames = frames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::setFrameSkip(uInt32 frames)
+{
+  mySkipFrames = frames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OSystemBench::setSoundCapture(const string& filename)
+{
+  SoundCapture* capture = new SoundCapture(this, filename);
+  if(!capture->isOpen())
+  {
+    delete capture;
+    return false;
+  }
+
+  delete mySound;
+  mySound = mySoundCapture = capture;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::mainLoop()
+{
+  MediaSource& media = myConsole->mediaSource();
+  System& system = myConsole->system();
+
+  myTotalTime = 0;
+  myRunAheadTime = 0;
+  myTotalCycles = 0;
+  myMinFrameTime = 0xffffffff;
+  myMaxFrameTime = 0;
+  myFrameChecksum = crc32(0L, Z_NULL, 0);
+
+  // Let the ROM get through its power-on code before measuring
+  for(uInt32 frame = 0; frame < myWarmupFrames; ++frame)
+    media.update();
+
+  double renderStart = mySoundCapture ? mySoundCapture->renderTime() : 0;
+
+  for(uInt32 frame = 0; frame < myNumberOfFrames; ++frame)
+  {
+    // A new frame resets the system cycle counter, a partial one doesn't
+    uInt32 startCycles = media.partialFrame() ? system.cycles() : 0;
+
+    bool shown = (frame % (mySkipFrames + 1)) == 0;
+    media.setRendering(shown);
+
+    uInt32 startTime = getTicks();
+    media.update();
+    uInt32 frameTime = getTicks() - startTime;
+
+    myTotalCycles += (double)(system.cycles() - startCycles);
+
+    // Not timed; the checksum is only used to compare builds
+    if(shown)
+      myFrameChecksum = crc32(myFrameChecksum, media.currentFrameBuffer(),
+                              media.width() * media.height());
+
+    // The frames run ahead are thrown away, so they aren't checksummed
+    if(shown && (myRunAheadFrames > 0))
+    {
+      startTime = getTicks();
+      if(myConsole->beginRunAhead(myRunAheadFrames, 0, false))
+        myConsole->endRunAhead();
+      uInt32 runAheadTime = getTicks() - startTime;
+
+      frameTime += runAheadTime;
+      myRunAheadTime += (double)runAheadTime;
+    }
+
+    myTotalTime += (double)frameTime;
+    if(frameTime < myMinFrameTime)  myMinFrameTime = frameTime;
+    if(frameTime > myMaxFrameTime)  myMaxFrameTime = frameTime;
+  }
+
+  if(mySoundCapture)
+    mySoundRenderTime = mySoundCapture->renderTime() - renderStart;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::printReport(ostream& out) const
+{
+  double seconds = myTotalTime / 1000000.0;
+  if(seconds <= 0)
+    seconds = 0.000001;
+
+  // Only the cycles of the real frames are counted, so the time spent
+  // running ahead is left out of the emulation speed
+  double emulationSeconds = (myTotalTime - myRunAheadTime) / 1000000.0;
+  if(emulationSeconds <= 0)
+    emulationSeconds = 0.000001;
+
+  double mhz = myTotalCycles / emulationSeconds / 1000000.0;
+
+  out << setiosflags(ios::fixed) << setprecision(3)
+      << "ROM:              " << romFile() << endl
+      << "Frames:           " << myNumberOfFrames
+      << " (+" << myWarmupFrames << " warm-up, run-ahead "
+      << myRunAheadFrames << ", skip " << mySkipFrames << ")" << endl
+      << "Wall time:        " << seconds << " s" << endl
+      << "Frames/sec:       " << (myNumberOfFrames / seconds) << endl
+      << "Emulated CPU:     " << mhz << " MHz ("
+      << (mhz / BENCH_CPU_MHZ) << "x real time)" << endl;
+
+  if(myNumberOfFrames > 0)
+    out << "Frame time (ms):  avg " << (myTotalTime / myNumberOfFrames / 1000.0)
+        << ", min " << (myMinFrameTime / 1000.0)
+        << ", max " << (myMaxFrameTime / 1000.0) << endl;
+
+  if(myRunAheadFrames > 0)
+    out << "Run-ahead time:   " << (myRunAheadTime / 1000000.0) << " s ("
+        << (myRunAheadTime / 10000.0 / seconds) << "% of wall time)"
+        << endl;
+
+  if(mySoundCapture)
+    out << "Sound capture:    " << mySoundCapture->samples()
+        << " samples, render " << (mySoundRenderTime / 1000.0) << " ms ("
+        << (mySoundRenderTime / 10000.0 / seconds) << "% of wall time)"
+        << endl;
+
+  out << "Frame checksum:   " << hex << setw(8) << setfill('0')
+      << myFrameChecksum << dec << setfill(' ') << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 OSystemBench::getTicks()
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uInt32) (now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystemBench::getScreenDimensions(int& width, int& height)
+{
+  width  = 480;
+  height = 272;
+}
@@ -0,0 +1,147 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef OSYSTEM_BENCH_HXX
+#define OSYSTEM_BENCH_HXX
+
+#include "bspf.hxx"
+#include "OSystem.hxx"
+
+class SoundCapture;
+
+/**
+  This class defines a headless system used to benchmark the emulation
+  core.  There is no menu, no input polling and no frame pacing: the main
+  loop simply runs the console's TIA/System/CPU for a fixed number of
+  frames as fast as possible and records how long each one took.
+
+  The video and sound objects must be the null ones (settings 'video'
+  set to "null" and 'sound' to false), so that only the core is measured.
+  The sound can instead be captured to a WAV file, which then also
+  measures the cost of rendering it.
+*/
+class OSystemBench : public OSystem
+{
+  public:
+    /**
+      Create a new benchmark operating system object
+    */
+    OSystemBench();
+
+    /**
+      Destructor
+    */
+    virtual ~OSystemBench();
+
+  public:
+    /**
+      Runs the warm-up frames, then the measured frames.
+    */
+    void mainLoop();
+
+    /**
+      This method returns number of ticks in microseconds, from a
+      monotonic clock.
+
+      @return Current time in microseconds.
+    */
+    uInt32 getTicks();
+
+    /**
+      This method queries the dimensions of the screen; we pretend to
+      have the same screen as the handheld.
+    */
+    void getScreenDimensions(int& width, int& height);
+
+    /**
+      Set the number of frames to run.
+
+      @param frames  The number of measured frames
+      @param warmup  The number of frames run before measuring starts
+    */
+    void setFrames(uInt32 frames, uInt32 warmup);
+
+    /**
+      Set the number of frames to run ahead after each measured frame,
+      as the handheld does with run-ahead enabled.  The speculative frames
+      are timed and reported apart, but the checksum and the emulated CPU
+      speed only cover the real ones.
+
+      @param frames  The number of frames to run ahead, 0 to disable
+    */
+    void setRunAhead(uInt32 frames);
+
+    /**
+      Set the number of frames skipped after each frame shown, as the
+      handheld does with frame skipping enabled.  The skipped frames are
+      timed but not drawn, and the checksum only covers the shown ones.
+
+      @param frames  The number of frames skipped, 0 to show them all
+    */
+    void setFrameSkip(uInt32 frames);
+
+    /**
+      Replace the sound object with one writing the sound to a WAV file.
+      Must be called after createSound() and before createConsole().
+
+      @param filename  The WAV file to write
+      @return          False if the file couldn't be created
+    */
+    bool setSoundCapture(const string& filename);
+
+    /**
+      Print the results of the last mainLoop() to the given stream.
+    */
+    void printReport(ostream& out) const;
+
+  private:
+    // Number of measured and warm-up frames
+    uInt32 myNumberOfFrames;
+    uInt32 myWarmupFrames;
+
+    // Number of frames run ahead after each measured frame
+    uInt32 myRunAheadFrames;
+
+    // Number of frames skipped after each frame shown
+    uInt32 mySkipFrames;
+
+    // Total wall time of the measured frames, in microseconds
+    double myTotalTime;
+
+    // Part of the total time spent running ahead, in microseconds
+    double myRunAheadTime;
+
+    // Fastest and slowest measured frame, in microseconds
+    uInt32 myMinFrameTime;
+    uInt32 myMaxFrameTime;
+
+    // Total number of CPU cycles emulated in the measured frames
+    double myTotalCycles;
+
+    // Running CRC of every measured frame, to check that a change to
+    // the core didn't alter the output
+    uInt32 myFrameChecksum;
+
+    // The sound object when the sound is captured, 0 otherwise
+    SoundCapture* mySoundCapture;
+
+    // Time spent rendering the sound of the measured frames, in microseconds
+    double mySoundRenderTime;
+};
+
+#endif
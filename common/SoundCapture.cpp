@@ -0,0 +1,313 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <string.h>
+
+#include "global.h"
+
+#include "bspf.hxx"
+#include "Serializer.hxx"
+#include "Deserializer.hxx"
+#include "Settings.hxx"
+#include "OSystem.hxx"
+#include "SoundCapture.hxx"
+
+// The system cycles are CPU cycles: the 3.579545 MHz NTSC colour clock
+// divided by three
+#define CAPTURE_COLOR_CLOCK     3579545ULL
+
+// Size of the RIFF/WAVE header, and number of sample frames rendered at once
+#define CAPTURE_HEADER_SIZE     44
+#define CAPTURE_CHUNK_SAMPLES   1024
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void putLittleEndian(uInt8* out, uInt32 value, uInt32 bytes)
+{
+  for(uInt32 i = 0; i < bytes; ++i)
+    out[i] = (uInt8)(value >> (8 * i));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundCapture::SoundCapture(OSystem* osystem, const string& filename,
+                           uInt32 frequency)
+  : Sound(osystem),
+    myFrequency(frequency),
+    myNumChannels(1),
+    myIsInitializedFlag(false),
+    myRegWriteCount(0),
+    myRegWriteCapacity(512),
+    myFrameStartCycle(0),
+    mySamplesWritten(0),
+    myRenderTime(0),
+    myLastRegisterSetCycle(0)
+{
+  myRegWrites = new RegWrite[myRegWriteCapacity];
+  mySampleBuffer = new Int16[CAPTURE_CHUNK_SAMPLES * 2];
+  myByteBuffer = new uInt8[CAPTURE_CHUNK_SAMPLES * 4];
+
+  // The sizes are filled in when the file is closed
+  myFile.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if(myFile.is_open())
+    writeHeader();
+  else
+    cerr << "WARNING: Couldn't create sound capture file " << filename << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundCapture::~SoundCapture()
+{
+  close();
+
+  if(myFile.is_open())
+  {
+    myFile.seekp(0, ios::beg);
+    writeHeader();
+    myFile.close();
+  }
+
+  delete[] myRegWrites;
+  delete[] mySampleBuffer;
+  delete[] myByteBuffer;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::setChannels(uInt32 channels)
+{
+  if((channels == 1 || channels == 2) && (mySamplesWritten == 0))
+    myNumChannels = channels;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::initialize()
+{
+  if(myIsInitializedFlag || !myFile.is_open())
+    return;
+
+  // Same setup as the SDL device, but always at full volume
+  myTIASound.outputFrequency(myFrequency);
+  myTIASound.tiaFrequency(myOSystem->settings().getInt("tiafreq"));
+  myTIASound.channels(myNumChannels);
+  myTIASound.clipVolume(myOSystem->settings().getBool("clipvol"));
+  myTIASound.bandLimit(ATARI.atari_snd_quality == ATARI_SND_QUALITY_HIGH);
+  myTIASound.stereoWidth(ATARI.atari_snd_width);
+  myTIASound.volume(100);
+
+  myRegWriteCount = 0;
+  myIsInitializedFlag = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::close()
+{
+  // Whatever the last frame played so far still goes to the file
+  if(myIsInitializedFlag && (myRegWriteCount > 0))
+    renderTo(myRegWrites[myRegWriteCount - 1].cycle);
+
+  myRegWriteCount = 0;
+  myIsInitializedFlag = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::reset()
+{
+  if(myIsInitializedFlag)
+  {
+    myRegWriteCount = 0;
+    myTIASound.reset();
+    myLastRegisterSetCycle = 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::set(uInt16 addr, uInt8 value, Int32 cycle)
+{
+  if(!myIsInitializedFlag)
+    return;
+
+  if(myRegWriteCount == myRegWriteCapacity)
+  {
+    RegWrite* writes = new RegWrite[myRegWriteCapacity * 2];
+    memcpy(writes, myRegWrites, myRegWriteCount * sizeof(RegWrite));
+    delete[] myRegWrites;
+    myRegWrites = writes;
+    myRegWriteCapacity *= 2;
+  }
+
+  RegWrite& info = myRegWrites[myRegWriteCount++];
+  info.cycle = cycle;
+  info.addr = addr;
+  info.value = value;
+
+  myLastRegisterSetCycle = cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::adjustCycleCounter(Int32 amount)
+{
+  myLastRegisterSetCycle += amount;
+
+  // The counter is moved back by the length of each frame, so the frame
+  // is complete: render it, applying each write on its own sample
+  if(myIsInitializedFlag && (amount < 0))
+  {
+    uInt32 startTime = myOSystem->getTicks();
+
+    for(uInt32 i = 0; i < myRegWriteCount; ++i)
+    {
+      renderTo(myRegWrites[i].cycle);
+      myTIASound.set(myRegWrites[i].addr, myRegWrites[i].value);
+    }
+    renderTo(-amount);
+
+    myRegWriteCount = 0;
+    myFrameStartCycle += -amount;
+
+    myRenderTime += (double)(myOSystem->getTicks() - startTime);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::renderTo(Int32 cycle)
+{
+  if(cycle < 0)
+    cycle = 0;
+
+  // Counted from the first frame so that rounding never accumulates
+  unsigned long long target =
+      (myFrameStartCycle + cycle) * myFrequency * 3 / CAPTURE_COLOR_CLOCK;
+
+  while(mySamplesWritten < target)
+  {
+    uInt32 samples = target - mySamplesWritten;
+    if(samples > CAPTURE_CHUNK_SAMPLES)
+      samples = CAPTURE_CHUNK_SAMPLES;
+
+    myTIASound.process(mySampleBuffer, samples);
+
+    // WAV files are little endian whatever the host is
+    uInt32 values = samples * myNumChannels;
+    for(uInt32 i = 0; i < values; ++i)
+      putLittleEndian(myByteBuffer + 2 * i, (uInt16)mySampleBuffer[i], 2);
+
+    myFile.write((const char*)myByteBuffer, values * 2);
+    mySamplesWritten += samples;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::writeHeader()
+{
+  uInt32 blockAlign = myNumChannels * 2;
+  uInt32 dataSize = mySamplesWritten * blockAlign;
+  uInt8 header[CAPTURE_HEADER_SIZE];
+
+  memcpy(header, "RIFF", 4);
+  putLittleEndian(header + 4, CAPTURE_HEADER_SIZE - 8 + dataSize, 4);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  putLittleEndian(header + 16, 16, 4);                       // Chunk size
+  putLittleEndian(header + 20, 1, 2);                        // PCM
+  putLittleEndian(header + 22, myNumChannels, 2);
+  putLittleEndian(header + 24, myFrequency, 4);
+  putLittleEndian(header + 28, myFrequency * blockAlign, 4); // Bytes/second
+  putLittleEndian(header + 32, blockAlign, 2);
+  putLittleEndian(header + 34, 16, 2);                       // Bits/sample
+  memcpy(header + 36, "data", 4);
+  putLittleEndian(header + 40, dataSize, 4);
+
+  myFile.write((const char*)header, CAPTURE_HEADER_SIZE);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundCapture::load(Deserializer& in)
+{
+  string device = "TIASound";
+
+  try
+  {
+    if(in.getString() != device)
+      return false;
+
+    uInt8 reg1 = 0, reg2 = 0, reg3 = 0, reg4 = 0, reg5 = 0, reg6 = 0;
+    reg1 = (uInt8) in.getInt();
+    reg2 = (uInt8) in.getInt();
+    reg3 = (uInt8) in.getInt();
+    reg4 = (uInt8) in.getInt();
+    reg5 = (uInt8) in.getInt();
+    reg6 = (uInt8) in.getInt();
+
+    myLastRegisterSetCycle = (Int32) in.getInt();
+
+    // The writes of the frame being replaced never happened
+    if(myIsInitializedFlag)
+    {
+      myRegWriteCount = 0;
+      myTIASound.set(0x15, reg1);
+      myTIASound.set(0x16, reg2);
+      myTIASound.set(0x17, reg3);
+      myTIASound.set(0x18, reg4);
+      myTIASound.set(0x19, reg5);
+      myTIASound.set(0x1a, reg6);
+    }
+  }
+  catch(...)
+  {
+    cerr << "Unknown error in load state for " << device << endl;
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundCapture::save(Serializer& out)
+{
+  string device = "TIASound";
+
+  try
+  {
+    out.putString(device);
+
+    uInt8 reg1 = 0, reg2 = 0, reg3 = 0, reg4 = 0, reg5 = 0, reg6 = 0;
+
+    if(myIsInitializedFlag)
+    {
+      reg1 = myTIASound.get(0x15);
+      reg2 = myTIASound.get(0x16);
+      reg3 = myTIASound.get(0x17);
+      reg4 = myTIASound.get(0x18);
+      reg5 = myTIASound.get(0x19);
+      reg6 = myTIASound.get(0x1a);
+    }
+
+    out.putInt(reg1);
+    out.putInt(reg2);
+    out.putInt(reg3);
+    out.putInt(reg4);
+    out.putInt(reg5);
+    out.putInt(reg6);
+
+    out.putInt(myLastRegisterSetCycle);
+  }
+  catch(...)
+  {
+    cerr << "Unknown error in save state for " << device << endl;
+    return false;
+  }
+
+  return true;
+}
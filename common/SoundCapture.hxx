@@ -0,0 +1,245 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef SOUND_CAPTURE_HXX
+#define SOUND_CAPTURE_HXX
+
+class OSystem;
+class Serializer;
+class Deserializer;
+
+#include <fstream>
+
+#include "bspf.hxx"
+#include "Sound.hxx"
+#include "TIASnd.hxx"
+
+/**
+  This class implements a sound object which writes the sound to a WAV
+  file instead of playing it.
+
+  There is no audio callback: the register writes of a frame are kept
+  with the system cycle they happened at, and when the frame ends the
+  whole frame is rendered at once, each write landing on the sample its
+  cycle falls on.  The output only depends on the emulation, so the same
+  ROM run for the same number of frames always gives the same file.
+*/
+class SoundCapture : public Sound
+{
+  public:
+    /**
+      Create a new sound object writing to the given file.  The init
+      method must be invoked before using the object.
+
+      @param osystem    The operating system object
+      @param filename   The WAV file to write
+      @param frequency  The sample rate of the WAV file
+    */
+    SoundCapture(OSystem* osystem, const string& filename,
+                 uInt32 frequency = 44100);
+
+    /**
+      Destructor, completes the WAV file
+    */
+    virtual ~SoundCapture();
+
+  public:
+    /**
+      Enables/disables the sound subsystem.
+
+      @param enable  Either true or false, to enable or disable the sound system
+    */
+    void setEnabled(bool enable) { }
+
+    /**
+      The system cycle counter is being adjusting by the specified amount.
+      This happens at the end of each frame, which is rendered to the file.
+
+      @param amount The amount the cycle counter is being adjusted by
+    */
+    void adjustCycleCounter(Int32 amount);
+
+    /**
+      Sets the number of channels (mono or stereo sound).  Only taken
+      into account before the first sample is written.
+
+      @param channels The number of channels
+    */
+    void setChannels(uInt32 channels);
+
+    /**
+      Sets the display framerate.  The sound is always rendered at the
+      speed of a real 2600, so it isn't used.
+
+      @param framerate The base framerate depending on NTSC or PAL ROM
+    */
+    void setFrameRate(uInt32 framerate) { }
+
+    /**
+      Initializes the sound device.  This must be called before any
+      calls are made to derived methods.
+    */
+    void initialize();
+
+    /**
+      Should be called to close the sound device.  Once called the sound
+      device can be started again using the initialize method.
+    */
+    void close();
+
+    /**
+      Return true iff the sound device was successfully initialized.
+
+      @return true iff the sound device was successfully initialized.
+    */
+    bool isSuccessfullyInitialized() const { return myIsInitializedFlag; }
+
+    /**
+      Set the mute state of the sound object.  The file always gets
+      everything, so it isn't used.
+
+      @param state Mutes sound if true, unmute if false
+    */
+    void mute(bool state) { }
+
+    /**
+      Reset the sound device.
+    */
+    void reset();
+
+    /**
+      Sets the sound register to a given value.
+
+      @param addr  The register address
+      @param value The value to save into the register
+      @param cycle The system cycle at which the register is being updated
+    */
+    void set(uInt16 addr, uInt8 value, Int32 cycle);
+
+    /**
+      Sets the volume of the sound device; the file is always written
+      at full volume, so it isn't used.
+
+      @param percent The new volume percentage level for the sound device
+    */
+    void setVolume(Int32 percent) { }
+
+    /**
+      Adjusts the volume of the sound device; the file is always written
+      at full volume, so it isn't used.
+
+      @param direction  Increase or decrease the current volume
+    */
+    void adjustVolume(Int8 direction) { }
+
+    /**
+      Answers how much sound has been emulated but not played; nothing
+      is played, so it's unknown.
+
+      @return Always a negative value
+    */
+    double bufferedDuration() { return -1.0; }
+
+  public:
+    /**
+      Answers whether the WAV file could be created.
+    */
+    bool isOpen() const { return myFile.is_open(); }
+
+    /**
+      Answers the number of sample frames written so far.
+    */
+    uInt32 samples() const { return mySamplesWritten; }
+
+    /**
+      Answers how long rendering the sound took, in microseconds.
+    */
+    double renderTime() const { return myRenderTime; }
+
+  public:
+    /**
+      Loads the current state of this device from the given Deserializer.
+
+      @param in The deserializer device to load from.
+      @return The result of the load.  True on success, false on failure.
+    */
+    bool load(Deserializer& in);
+
+    /**
+      Saves the current state of this device to the given Serializer.
+
+      @param out The serializer device to save to.
+      @return The result of the save.  True on success, false on failure.
+    */
+    bool save(Serializer& out);
+
+  private:
+    // Renders the samples up to the one the given cycle of the current
+    // frame falls on, and writes them to the file
+    void renderTo(Int32 cycle);
+
+    // Writes the RIFF header, with the sizes of the samples written so far
+    void writeHeader();
+
+  private:
+    // A register write, at a system cycle of the current frame
+    struct RegWrite
+    {
+      Int32 cycle;
+      uInt16 addr;
+      uInt8 value;
+    };
+
+    // TIASound emulation object
+    TIASound myTIASound;
+
+    // The WAV file
+    ofstream myFile;
+
+    // Sample rate of the WAV file
+    uInt32 myFrequency;
+
+    // Number of channels, fixed once the first sample is written
+    uInt32 myNumChannels;
+
+    // Indicates if the sound device was successfully initialized
+    bool myIsInitializedFlag;
+
+    // The register writes of the current frame, in order
+    RegWrite* myRegWrites;
+    uInt32 myRegWriteCount;
+    uInt32 myRegWriteCapacity;
+
+    // System cycles from the first frame to the start of the current one
+    unsigned long long myFrameStartCycle;
+
+    // Number of sample frames written to the file
+    uInt32 mySamplesWritten;
+
+    // Where samples are rendered before being written
+    Int16* mySampleBuffer;
+    uInt8* myByteBuffer;
+
+    // Time spent rendering, in microseconds
+    double myRenderTime;
+
+    // Kept for the state files, which have the same layout as SoundSDL's
+    Int32 myLastRegisterSetCycle;
+};
+
+#endif
@@ -136,6 +136,14 @@ class SoundNull : public Sound
     */
     void adjustVolume(Int8 direction) { }
 
+    /**
+      Answers how much sound has been emulated but not played; there's
+      no sound device, so it's unknown.
+
+      @return Always a negative value
+    */
+    double bufferedDuration() { return -1.0; }
+
 public:
     /**
       Loads the current state of this device from the given Deserializer.
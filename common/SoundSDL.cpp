@@ -34,6 +34,17 @@
 
 #include "SoundSDL.hxx"
 
+// In rate control mode the sound is played up to 0.5% faster or slower,
+// which can't be heard, to keep about a fragment and a frame of it waiting
+#define SOUND_RATE_MAX_ADJUST   0.005
+#define SOUND_RATE_SMOOTHING    0.05
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline uInt32 soundClock(double seconds)
+{
+  return (uInt32)(unsigned long long)(seconds * 1000000.0);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::SoundSDL(OSystem* osystem)
   : Sound(osystem),
@@ -44,7 +55,14 @@ SoundSDL::SoundSDL(OSystem* osystem)
     myNumChannels(1),
     myFragmentSizeLogBase2(0),
     myIsMuted(false),
-    myVolume(100)
+    myVolume(100),
+    myRegWriteQueueDrained(false),
+    myEmulatedTime(0.0),
+    myPlayedTime(0.0),
+    myEmulatedClock(0),
+    myPlayedClock(0),
+    myRateRatio(1.0),
+    myAverageFill(0.0)
 {
 }
 
@@ -75,8 +93,13 @@ void SoundSDL::initialize()
   }
 
   // Make sure the sound queue is clear
+  SDL_LockAudio();
   myRegWriteQueue.clear();
   myTIASound.reset();
+  myEmulatedTime = myPlayedTime;
+  myEmulatedClock.store(soundClock(myEmulatedTime),
+                        std::memory_order_relaxed);
+  SDL_UnlockAudio();
 
   if(! SDL_WasInit(SDL_INIT_AUDIO)) {
     myIsInitializedFlag = false;
@@ -105,9 +128,10 @@ void SoundSDL::initialize()
       desired.callback = callback;
       desired.userdata = (void*)this;
 # else
+      // Always stereo: how far apart the TIA channels are is a setting
       desired.freq   = 44100;
-      desired.format = AUDIO_S16;
-      desired.channels = myNumChannels;
+      desired.format = AUDIO_S16SYS;
+      desired.channels = 2;
       desired.samples  = fragsize;
       desired.callback = callback;
       desired.userdata = (void*)this;
@@ -148,6 +172,7 @@ void SoundSDL::initialize()
       myTIASound.outputFrequency(myHardwareSpec.freq);
       myTIASound.tiaFrequency(tiafreq);
       myTIASound.channels(myHardwareSpec.channels);
+      myTIASound.bandLimit(ATARI.atari_snd_quality == ATARI_SND_QUALITY_HIGH);
 
       bool clipvol = myOSystem->settings().getBool("clipvol");
       myTIASound.clipVolume(clipvol);
@@ -213,7 +238,9 @@ void SoundSDL::mute(bool state)
 # if 0 //LUDO:
     SDL_PauseAudio(myIsMuted ? 1 : 0);
 # endif
+    SDL_LockAudio();
     myRegWriteQueue.clear();
+    SDL_UnlockAudio();
   }
 }
 
@@ -227,7 +254,9 @@ void SoundSDL::reset()
 # endif
     myIsMuted = false;
     myLastRegisterSetCycle = 0;
+    SDL_LockAudio();
     myRegWriteQueue.clear();
+    SDL_UnlockAudio();
 # if 0 //LUDO:
     SDL_PauseAudio(0);
 # endif
@@ -244,7 +273,6 @@ void SoundSDL::setVolume(Int32 percent)
       myOSystem->settings().setInt("volume", percent);
       SDL_LockAudio();
       myVolume = percent;
-      myTIASound.volume(percent);
       SDL_UnlockAudio();
     }
   }
@@ -280,6 +308,16 @@ void SoundSDL::adjustVolume(Int8 direction)
 void SoundSDL::adjustCycleCounter(Int32 amount)
 {
   myLastRegisterSetCycle += amount;
+
+  // The counter is moved back by the length of each frame, so this is
+  // where the emulated time goes forward
+  if(myIsInitializedFlag && (amount < 0))
+  {
+    myEmulatedTime += (-amount / 1193191.66666667) *
+        (myDisplayFrameRate / (double)myOSystem->frameRate());
+    myEmulatedClock.store(soundClock(myEmulatedTime),
+                          std::memory_order_relaxed);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -300,10 +338,30 @@ void SoundSDL::setFrameRate(uInt32 framerate)
   myLastRegisterSetCycle = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double SoundSDL::bufferedDuration()
+{
+  if(!myIsInitializedFlag)
+    return -1.0;
+
+  // The sound callback drops the silence played after running late, so
+  // the device may briefly look ahead of the emulation
+  Int32 buffered = (Int32)(soundClock(myEmulatedTime) -
+                           myPlayedClock.load(std::memory_order_relaxed));
+
+  return (buffered > 0) ? buffered / 1000000.0 : 0.0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
 {
-  SDL_LockAudio();
+  // If the sound callback ran out of writes it finished its fragment with
+  // the current settings, so this one is timed from the start of the frame
+  if(myRegWriteQueueDrained.load(std::memory_order_relaxed) &&
+     myRegWriteQueueDrained.exchange(false))
+  {
+    myLastRegisterSetCycle = 0;
+  }
 
   // First, calulate how many seconds would have past since the last
   // register write on a real 2600
@@ -319,12 +377,14 @@ void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
   info.addr = addr;
   info.value = value;
   info.delta = delta;
-  myRegWriteQueue.enqueue(info);
-
-  // Update last cycle counter to the current cycle
-  myLastRegisterSetCycle = cycle;
 
-  SDL_UnlockAudio();
+  // The queue only fills up if the sound callback stopped running; the
+  // write is dropped then, but its time is kept for the next one
+  if(myRegWriteQueue.enqueue(info))
+  {
+    // Update last cycle counter to the current cycle
+    myLastRegisterSetCycle = cycle;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -333,11 +393,45 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
   if(!myIsInitializedFlag)
     return;
 
+  // The samples are rendered straight into the device's buffer
+  Int16* buffer = (Int16*)stream;
   uInt32 channels = myHardwareSpec.channels;
-  length = length / channels;
+  length = length / (channels * sizeof(Int16));
+
+  // The handheld's volume (and whether the sound is on) is applied by
+  // the TIA sound's volume table
+  myTIASound.volume(ATARI.atari_snd_enable ?
+      myVolume * gp2xGetSoundVolume() * 70 / 10000 : 0);
+  myTIASound.stereoWidth(ATARI.atari_snd_width);
+
+  // The silence played after running late (or while the emulation was
+  // stopped) doesn't have to be made up for
+  Int32 ahead = (Int32)(soundClock(myPlayedTime) -
+                        myEmulatedClock.load(std::memory_order_relaxed));
+  if(ahead > 0)
+    myPlayedTime -= ahead / 1000000.0;
+
+  // Rate control needs the emulation to run at its real speed, which the
+  // speed limiter does
+  bool rateControl = (ATARI.atari_sync_audio == ATARI_SYNC_RESAMPLE) &&
+                     (ATARI.atari_speed_limiter > 0);
+  updateRateRatio(rateControl, length);
+
+  // Samples are generated at a slightly different frequency instead of
+  // dropping register writes or running out of them
+  double frequency = myHardwareSpec.freq / myRateRatio;
+  myTIASound.outputFrequency((Int32)frequency);
+
+  // The sound quality can be changed from the menu at any time
+  myTIASound.bandLimit(ATARI.atari_snd_quality == ATARI_SND_QUALITY_HIGH);
+
+  // Keep track of how much emulated sound the device has been given
+  myPlayedTime += length / frequency;
+  myPlayedClock.store(soundClock(myPlayedTime), std::memory_order_relaxed);
 
   // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > 
+  // (in rate control mode it only happens if the emulation stalled)
+  if(myRegWriteQueue.duration() > (rateControl ? 4.0 : 1.0) *
       (myFragmentSizeLogBase2 / myDisplayFrameRate))
   {
     double removed = 0.0;
@@ -361,14 +455,15 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
       // There are no more pending TIA sound register updates so we'll
       // use the current settings to finish filling the sound fragment
 //    myTIASound.process(stream + (uInt32)position, length - (uInt32)position);
-      myTIASound.process(stream + ((uInt32)position * channels),
+      myTIASound.process(buffer + ((uInt32)position * channels),
           length - (uInt32)position);
 
       // Since we had to fill the fragment we'll reset the cycle counter
       // to zero.  NOTE: This isn't 100% correct, however, it'll do for
       // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
+      // the delta of the next write.  The counter belongs to the
+      // emulation, which resets it on its next write.
+      myRegWriteQueueDrained.store(true, std::memory_order_relaxed);
       break;
     }
     else
@@ -378,7 +473,7 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
       RegWrite& info = myRegWriteQueue.front();
 
       // How long will the remaining samples in the fragment take to play
-      double duration = remaining / (double)myHardwareSpec.freq;
+      double duration = remaining / frequency;
 
       // Does the register update occur before the end of the fragment?
       if(info.delta <= duration)
@@ -389,11 +484,11 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
         {
           // Process the fragment upto the next TIA register write.  We
           // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
+          double samples = (frequency * info.delta);
 //        myTIASound.process(stream + (uInt32)position, (uInt32)samples +
 //            (uInt32)(position + samples) - 
 //            ((uInt32)position + (uInt32)samples));
-          myTIASound.process(stream + ((uInt32)position * channels),
+          myTIASound.process(buffer + ((uInt32)position * channels),
               (uInt32)samples + (uInt32)(position + samples) - 
               ((uInt32)position + (uInt32)samples));
 
@@ -409,7 +504,7 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
         // this fragment with the current TIA settings and reduce the register
         // update delay by the corresponding amount of time
 //      myTIASound.process(stream + (uInt32)position, length - (uInt32)position);
-        myTIASound.process(stream + ((uInt32)position * channels),
+        myTIASound.process(buffer + ((uInt32)position * channels),
             length - (uInt32)position);
         info.delta -= duration;
         break;
@@ -418,25 +513,41 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
   }
 }
 
-static uInt8 sound_buffer[2048];
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL::updateRateRatio(bool rateControl, uInt32 samples)
+{
+  if(!rateControl)
+  {
+    myRateRatio = 1.0;
+    return;
+  }
 
+  // The fill goes up by a frame and down by a fragment at a time, so it's
+  // smoothed before being compared with the sum of the two
+  Int32 waiting = (Int32)(myEmulatedClock.load(std::memory_order_relaxed) -
+                          soundClock(myPlayedTime));
+  double fill = (waiting > 0) ? waiting / 1000000.0 : 0.0;
+  myAverageFill += (fill - myAverageFill) * SOUND_RATE_SMOOTHING;
+
+  double target = (double)samples / myHardwareSpec.freq +
+      1.0 / myDisplayFrameRate;
+  double error = (myAverageFill - target) / target;
+  if(error > 1.0)
+    error = 1.0;
+  else if(error < -1.0)
+    error = -1.0;
+
+  myRateRatio = 1.0 + error * SOUND_RATE_MAX_ADJUST;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::callback(void* udata, uInt8* stream, int len)
 {
   SoundSDL* sound = (SoundSDL*)udata;
-  sound->processFragment(sound_buffer, len);
-# if 0 //LUDO:
-  /* Convert 8 bits in 16 bits samples */
-  for (int index = 0; index < len; index++) {
-    stream[index] = sound_buffer[index >> 1];
-  }
-# else
-  if (ATARI.atari_snd_enable) {
-    long volume = (SDL_MIX_MAXVOLUME * gp2xGetSoundVolume() * 70 / 100) / 100;
-    SDL_MixAudio(stream, (unsigned char *)sound_buffer, len, volume);
-  } else {
+  if(sound->myIsInitializedFlag)
+    sound->processFragment(stream, len);
+  else
     memset(stream, 0, len);
-  }
-# endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -466,6 +577,7 @@ bool SoundSDL::load(Deserializer& in)
 # if 0 //LUDO:
       SDL_PauseAudio(1);
 # endif
+      SDL_LockAudio();
       myRegWriteQueue.clear();
       myTIASound.set(0x15, reg1);
       myTIASound.set(0x16, reg2);
@@ -473,6 +585,7 @@ bool SoundSDL::load(Deserializer& in)
       myTIASound.set(0x18, reg4);
       myTIASound.set(0x19, reg5);
       myTIASound.set(0x1a, reg6);
+      SDL_UnlockAudio();
 # if 0 //LUDO:
       SDL_PauseAudio(0);
 # endif
@@ -543,13 +656,16 @@ bool SoundSDL::save(Serializer& out)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::RegWriteQueue::RegWriteQueue(uInt32 capacity)
-  : myCapacity(capacity),
-    myBuffer(0),
-    mySize(0),
+  : myBuffer(0),
+    myMask(1),
     myHead(0),
     myTail(0)
 {
-  myBuffer = new RegWrite[myCapacity];
+  while(myMask < capacity)
+    myMask <<= 1;
+
+  myBuffer = new RegWrite[myMask];
+  myMask -= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -561,71 +677,61 @@ SoundSDL::RegWriteQueue::~RegWriteQueue()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::clear()
 {
-  myHead = myTail = mySize = 0;
+  myHead.store(myTail.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::dequeue()
 {
-  if(mySize > 0)
+  uInt32 head = myHead.load(std::memory_order_relaxed);
+  if(head != myTail.load(std::memory_order_acquire))
   {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
+    // Hands the slot back to the producer
+    myHead.store(head + 1, std::memory_order_release);
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double SoundSDL::RegWriteQueue::duration()
 {
+  uInt32 head = myHead.load(std::memory_order_relaxed);
+  uInt32 tail = myTail.load(std::memory_order_acquire);
+
   double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
+  for(uInt32 i = head; i != tail; ++i)
   {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
+    duration += myBuffer[i & myMask].delta;
   }
   return duration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
+bool SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
 {
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-  {
-    grow();
-  }
+  uInt32 tail = myTail.load(std::memory_order_relaxed);
+  if(tail - myHead.load(std::memory_order_acquire) > myMask)
+    return false;
 
-  myBuffer[myTail] = info;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
+  myBuffer[tail & myMask] = info;
+
+  // Publishes the item to the consumer
+  myTail.store(tail + 1, std::memory_order_release);
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::RegWrite& SoundSDL::RegWriteQueue::front()
 {
-  assert(mySize != 0);
-  return myBuffer[myHead];
+  assert(size() != 0);
+  return myBuffer[myHead.load(std::memory_order_relaxed) & myMask];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 SoundSDL::RegWriteQueue::size() const
 {
-  return mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::grow()
-{
-  RegWrite* buffer = new RegWrite[myCapacity * 2];
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-  }
-  myHead = 0;
-  myTail = mySize;
-  myCapacity = myCapacity * 2;
-  delete[] myBuffer;
-  myBuffer = buffer;
+  return myTail.load(std::memory_order_acquire) -
+         myHead.load(std::memory_order_acquire);
 }
 
 #endif  // SOUND_SUPPORT
@@ -23,6 +23,7 @@
 
 class OSystem;
 
+#include <atomic>
 #include <SDL/SDL.h>
 
 #include "Sound.hxx"
@@ -30,6 +31,10 @@ class OSystem;
 #include "MediaSrc.hxx"
 #include "TIASnd.hxx"
 
+// Size of the CPU data cache lines, which the sound callback and the
+// emulation shouldn't be writing to at the same time
+#define SOUND_CACHE_LINE_SIZE 64
+
 /**
   This class implements the sound API for SDL.
 
@@ -138,6 +143,14 @@ class SoundSDL : public Sound
     */
     void adjustVolume(Int8 direction);
 
+    /**
+      Answers how much sound, in seconds, has been emulated but not yet
+      handed to the sound device.
+
+      @return The buffered duration, or a negative value if it's unknown
+    */
+    double bufferedDuration();
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -159,8 +172,8 @@ class SoundSDL : public Sound
     /**
       Invoked by the sound callback to process the next sound fragment.
 
-      @param stream Pointer to the start of the fragment
-      @param length Length of the fragment
+      @param stream Pointer to the start of the fragment (signed 16-bit)
+      @param length Length of the fragment in bytes
     */
     void processFragment(uInt8* stream, Int32 length);
 
@@ -174,18 +187,19 @@ class SoundSDL : public Sound
     };
 
     /**
-      A queue class used to hold TIA sound register writes before being
-      processed while creating a sound fragment.
+      A fixed size queue used to hand TIA sound register writes from the
+      emulation (its only producer) to the sound callback (its only
+      consumer) without locking.  Each side only moves its own index, and
+      the two indices are kept on separate cache lines.
     */
     class RegWriteQueue
     {
       public:
         /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
+          Create a new queue instance with the specified capacity, rounded
+          up to a power of two.  The queue never allocates after this.
         */
-        RegWriteQueue(uInt32 capacity = 512);
+        RegWriteQueue(uInt32 capacity = 8192);
 
         /**
           Destroy this queue instance.
@@ -194,27 +208,30 @@ class SoundSDL : public Sound
 
       public:
         /**
-          Clear any items stored in the queue.
+          Clear any items stored in the queue.  Neither side may be using
+          the queue meanwhile (i.e. the sound callback must be locked out).
         */
         void clear();
 
         /**
-          Dequeue the first object in the queue.
+          Dequeue the first object in the queue (consumer only).
         */
         void dequeue();
 
         /**
-          Return the duration of all the items in the queue.
+          Return the duration of all the items in the queue (consumer only).
         */
         double duration();
 
         /**
-          Enqueue the specified object.
+          Enqueue the specified object (producer only).
+
+          @return False if the queue is full, in which case it's dropped
         */
-        void enqueue(const RegWrite& info);
+        bool enqueue(const RegWrite& info);
 
         /**
-          Return the item at the front on the queue.
+          Return the item at the front on the queue (consumer only).
 
           @return The item at the front of the queue.
         */
@@ -228,15 +245,17 @@ class SoundSDL : public Sound
         uInt32 size() const;
 
       private:
-        // Increase the size of the queue
-        void grow();
-
-      private:
-        uInt32 myCapacity;
         RegWrite* myBuffer;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
+        uInt32 myMask;
+
+        // Index of the next item to dequeue, only moved by the consumer,
+        // and of the next item to enqueue, only moved by the producer.
+        // Both keep counting up and are masked to index the buffer.
+        uInt8 myHeadPad[SOUND_CACHE_LINE_SIZE];
+        std::atomic<uInt32> myHead;
+        uInt8 myTailPad[SOUND_CACHE_LINE_SIZE - sizeof(std::atomic<uInt32>)];
+        std::atomic<uInt32> myTail;
+        uInt8 myEndPad[SOUND_CACHE_LINE_SIZE - sizeof(std::atomic<uInt32>)];
     };
 
   private:
@@ -273,6 +292,33 @@ class SoundSDL : public Sound
     // Queue of TIA register writes
     RegWriteQueue myRegWriteQueue;
 
+    // Set by the sound callback when it ran out of register writes, so
+    // the next write is timed from the start of the frame
+    std::atomic<bool> myRegWriteQueueDrained;
+
+    // Seconds of sound emulated so far (from the cycles of each frame),
+    // kept by the emulation, and handed to the sound device so far, kept
+    // by the sound callback
+    double myEmulatedTime;
+    double myPlayedTime;
+
+    // The same in microseconds, for the other thread to read without a
+    // lock: each is only written by the thread keeping the time, and they
+    // wrap around, so only their difference means anything
+    std::atomic<uInt32> myEmulatedClock;
+    std::atomic<uInt32> myPlayedClock;
+
+    // Emulated time played per second of sound, close to 1, and the
+    // (smoothed) emulated time waiting to be played it was set from
+    double myRateRatio;
+    double myAverageFill;
+
+  private:
+    // Works out the resampling ratio to generate the next samples with:
+    // in rate control mode it follows how much emulated sound is waiting
+    // to be played, otherwise it's 1
+    void updateRateRatio(bool rateControl, uInt32 samples);
+
   private:
     // Callback function invoked by the SDL Audio library when it needs data
     static void callback(void* udata, uInt8* stream, int len);
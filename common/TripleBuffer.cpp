@@ -0,0 +1,47 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "TripleBuffer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TripleBuffer::TripleBuffer()
+  : myBack(0),
+    myFront(2),
+    myMiddle(1)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TripleBuffer::publish()
+{
+  // Releases the buffer just written to the reader, and acquires the one
+  // the reader let go of
+  myBack = myMiddle.exchange(myBack | kFresh, std::memory_order_acq_rel) &
+           kIndexMask;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TripleBuffer::update()
+{
+  if(!(myMiddle.load(std::memory_order_relaxed) & kFresh))
+    return false;
+
+  myFront = myMiddle.exchange(myFront, std::memory_order_acq_rel) &
+            kIndexMask;
+  return true;
+}
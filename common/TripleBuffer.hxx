@@ -0,0 +1,84 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef TRIPLE_BUFFER_HXX
+#define TRIPLE_BUFFER_HXX
+
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+  This class hands the newest of a series of buffers from one thread to
+  another without locking either of them.
+
+  There are three buffers: the writer fills the back one, the reader
+  uses the front one, and the one in the middle is the newest complete
+  buffer.  Publishing swaps the back buffer with the middle one, taking
+  the newest one swaps the middle buffer with the front one, so each
+  side always owns a buffer the other never touches.  Only the index of
+  the middle buffer is shared, and it's only ever exchanged atomically.
+
+  The writer never waits: if it publishes faster than the reader takes
+  the buffers, the ones in between are simply never seen.
+*/
+class TripleBuffer
+{
+  public:
+    /**
+      Creates a new triple buffer, with no buffer published yet
+    */
+    TripleBuffer();
+
+  public:
+    /**
+      Answers the buffer (0, 1 or 2) the writer fills; only the writer
+      may call it.
+    */
+    uInt32 back() const { return myBack; }
+
+    /**
+      Answers the buffer (0, 1 or 2) the reader uses; only the reader
+      may call it.
+    */
+    uInt32 front() const { return myFront; }
+
+    /**
+      Makes the back buffer the newest one, and gives the writer another
+      buffer to fill.  Only the writer may call it.
+    */
+    void publish();
+
+    /**
+      Makes the newest buffer the front one, if one was published since
+      the last call.  Only the reader may call it.
+
+      @return True if there is a new front buffer
+    */
+    bool update();
+
+  private:
+    // Set in myMiddle when it was published and not taken yet
+    enum { kFresh = 4, kIndexMask = 3 };
+
+    uInt32 myBack;
+    uInt32 myFront;
+    std::atomic<uInt32> myMiddle;
+};
+
+#endif
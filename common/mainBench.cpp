@@ -0,0 +1,139 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+//
+// Headless benchmark: loads a ROM and runs the emulation core for a fixed
+// number of frames with null video and sound, then reports the speed.
+// The sound can be written to a WAV file instead, rendered frame by frame
+// from the emulated cycles, so the file only depends on the emulation.
+//
+//   rg350-a2600-bench [-frames n] [-warmup n] [-cpu low|high]
+//                     [-runahead n] [-skip n] [-wav file [-quality fast|high]]
+//                     romfile
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bspf.hxx"
+#include "EventHandler.hxx"
+#include "PropsSet.hxx"
+#include "Settings.hxx"
+#include "OSystem.hxx"
+#include "SettingsPSP.hxx"
+#include "OSystemBench.hxx"
+
+#include "Atari.h"
+
+// The state the handheld front-end keeps in Atari.cpp, which the core
+// reads its settings from
+Atari_t ATARI;
+
+static void usage(const char* name)
+{
+  cerr << "Usage: " << name
+       << " [-frames n] [-warmup n] [-cpu low|high] [-runahead n]"
+       << " [-skip n] [-wav file [-quality fast|high]] romfile" << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  uInt32 frames = 3000, warmup = 60, runAhead = 0, skip = 0;
+  string cpu = "";
+  string wavfile = "", quality = "";
+  string romfile = "";
+
+  for(int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    bool hasValue = (i + 1 < argc);
+
+    if(arg == "-frames" && hasValue)
+      frames = atoi(argv[++i]);
+    else if(arg == "-warmup" && hasValue)
+      warmup = atoi(argv[++i]);
+    else if(arg == "-cpu" && hasValue)
+      cpu = argv[++i];
+    else if(arg == "-runahead" && hasValue)
+      runAhead = atoi(argv[++i]);
+    else if(arg == "-skip" && hasValue)
+      skip = atoi(argv[++i]);
+    else if(arg == "-wav" && hasValue)
+      wavfile = argv[++i];
+    else if(arg == "-quality" && hasValue)
+      quality = argv[++i];
+    else if(arg[0] != '-' && romfile == "")
+      romfile = arg;
+    else
+    {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if(romfile == "")
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  memset(&ATARI, 0, sizeof(Atari_t));
+  if(quality == "high")
+    ATARI.atari_snd_quality = ATARI_SND_QUALITY_HIGH;
+
+  OSystemBench* osystem = new OSystemBench();
+  SettingsPSP settings(osystem);
+
+  settings.setString("video", "null");
+  settings.setBool("sound", false);
+  if(cpu != "")
+    settings.setString("cpu", cpu);
+
+  osystem->create();
+
+  EventHandler handler(osystem);
+  PropertiesSet propertiesSet(osystem);
+  osystem->attach(&propertiesSet);
+
+  osystem->createFrameBuffer();
+  osystem->createSound();
+
+  // The TIA is handed the sound object when the console is created
+  if(wavfile != "" && !osystem->setSoundCapture(wavfile))
+  {
+    delete osystem;
+    return 1;
+  }
+
+  if(!osystem->createConsole(romfile))
+  {
+    delete osystem;
+    return 1;
+  }
+
+  osystem->setFrames(frames, warmup);
+  osystem->setRunAhead(runAhead);
+  osystem->setFrameSkip(skip);
+  osystem->mainLoop();
+  osystem->printReport(cout);
+
+  delete osystem;
+
+  return 0;
+}
@@ -78,19 +78,17 @@ void Cartridge3E::install(System& system)
   // Set the page accessing methods for the hot spots (for 100% emulation
   // I would need to chain any accesses below 0x40 to the TIA but for
   // now I'll just forget about them)
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = 0x00; i < 0x40; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
   // Setup the second segment to always point to the last ROM slice
   for(uInt32 j = 0x1800; j < 0x2000; j += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = &myImage[(mySize - 2048) + (j & 0x07FF)];
     access.directPokeBase = 0;
     mySystem->setPageAccess(j >> shift, access);
@@ -182,8 +180,7 @@ void Cartridge3E::bank(uInt16 bank)
     uInt16 shift = mySystem->pageShift();
   
     // Setup the page access methods for the current bank
-    System::PageAccess access;
-    access.device = this;
+    System::PageAccess access(this);
     access.directPokeBase = 0;
   
     // Map ROM image into the system
@@ -204,8 +201,7 @@ void Cartridge3E::bank(uInt16 bank)
     uInt32 address;
   
     // Setup the page access methods for the current bank
-    System::PageAccess access;
-    access.device = this;
+    System::PageAccess access(this);
     access.directPokeBase = 0;
   
     // Map read-port RAM image into the system
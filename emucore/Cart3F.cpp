@@ -71,19 +71,17 @@ void Cartridge3F::install(System& system)
   // we need to chain any accesses below 0x40 to the TIA. Our poke() method
   // does this via mySystem->tiaPoke(...), at least until we come up with a
   // cleaner way to do it.)
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = 0x00; i < 0x40; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
   // Setup the second segment to always point to the last ROM slice
   for(uInt32 j = 0x1800; j < 0x2000; j += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = &myImage[(mySize - 2048) + (j & 0x07FF)];
     access.directPokeBase = 0;
     mySystem->setPageAccess(j >> shift, access);
@@ -158,8 +156,7 @@ void Cartridge3F::bank(uInt16 bank)
   uInt16 shift = mySystem->pageShift();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   // Map ROM image into the system
@@ -59,9 +59,8 @@ void Cartridge4K::install(System& system)
   // Make sure the system we're being installed in has a page size that'll work
   assert((0x1000 & mask) == 0);
 
-  System::PageAccess access;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
-  access.device = this;
 
   // Map ROM image into the system
   for(uInt32 address = 0x1000; address < 0x2000; address += (1 << shift))
@@ -97,12 +97,11 @@ void CartridgeAR::install(System& system)
   // Make sure the system we're being installed in has a page size that'll work
   assert((0x1000 & mask) == 0);
 
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = 0x1000; i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
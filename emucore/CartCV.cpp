@@ -89,9 +89,8 @@ void CartridgeCV::install(System& system)
   // Make sure the system we're being installed in has a page size that'll work
   assert((0x1800 & mask) == 0);
 
-  System::PageAccess access;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
-  access.device = this;
 
   // Map ROM image into the system
   for(uInt32 address = 0x1800; address < 0x2000; address += (1 << shift))
@@ -103,7 +102,6 @@ void CartridgeCV::install(System& system)
   // Set the page accessing method for the RAM writing pages
   for(uInt32 j = 0x1400; j < 0x1800; j += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = 0;
     access.directPokeBase = &myRAM[j & 0x03FF];
     mySystem->setPageAccess(j >> shift, access);
@@ -112,7 +110,6 @@ void CartridgeCV::install(System& system)
   // Set the page accessing method for the RAM reading pages
   for(uInt32 k = 0x1000; k < 0x1400; k += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = &myRAM[k & 0x03FF];
     access.directPokeBase = 0;
     mySystem->setPageAccess(k >> shift, access);
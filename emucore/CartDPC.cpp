@@ -105,12 +105,11 @@ void CartridgeDPC::install(System& system)
   assert(((0x1080 & mask) == 0) && ((0x1100 & mask) == 0));
 
   // Set the page accessing methods for the hot spots
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = (0x1FF8 & ~mask); i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
@@ -119,7 +118,6 @@ void CartridgeDPC::install(System& system)
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(j >> shift, access);
   }
 
@@ -454,8 +452,7 @@ void CartridgeDPC::bank(uInt16 bank)
   uInt16 mask = mySystem->pageMask();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   // Map Program ROM image into the system
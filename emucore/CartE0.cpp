@@ -65,9 +65,8 @@ void CartridgeE0::install(System& system)
       ((0x1800 & mask) == 0) && ((0x1C00 & mask) == 0));
 
   // Set the page acessing methods for the first part of the last segment
-  System::PageAccess access;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
-  access.device = this;
   for(uInt32 i = 0x1C00; i < (0x1FE0U & ~mask); i += (1 << shift))
   {
     access.directPeekBase = &myImage[7168 + (i & 0x03FF)];
@@ -78,7 +77,6 @@ void CartridgeE0::install(System& system)
   // Set the page accessing methods for the hot spots in the last segment
   access.directPeekBase = 0;
   access.directPokeBase = 0;
-  access.device = this;
   for(uInt32 j = (0x1FE0 & ~mask); j < 0x2000; j += (1 << shift))
   {
     mySystem->setPageAccess(j >> shift, access);
@@ -153,8 +151,7 @@ void CartridgeE0::segmentZero(uInt16 slice)
   uInt16 shift = mySystem->pageShift();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   for(uInt32 address = 0x1000; address < 0x1400; address += (1 << shift))
@@ -173,8 +170,7 @@ void CartridgeE0::segmentOne(uInt16 slice)
   uInt16 shift = mySystem->pageShift();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   for(uInt32 address = 0x1400; address < 0x1800; address += (1 << shift))
@@ -193,8 +189,7 @@ void CartridgeE0::segmentTwo(uInt16 slice)
   uInt16 shift = mySystem->pageShift();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   for(uInt32 address = 0x1800; address < 0x1C00; address += (1 << shift))
@@ -72,19 +72,17 @@ void CartridgeE7::install(System& system)
       ((0x1900 & mask) == 0) && ((0x1A00 & mask) == 0));
 
   // Set the page accessing methods for the hot spots
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = (0x1FE0 & ~mask); i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
   // Setup the second segment to always point to the last ROM slice
   for(uInt32 j = 0x1A00; j < (0x1FE0U & ~mask); j += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = &myImage[7 * 2048 + (j & 0x07FF)];
     access.directPokeBase = 0;
     mySystem->setPageAccess(j >> shift, access);
@@ -159,8 +157,7 @@ void CartridgeE7::bank(uInt16 slice)
   // Setup the page access methods for the current bank
   if(slice != 7)
   {
-    System::PageAccess access;
-    access.device = this;
+    System::PageAccess access(this);
     access.directPokeBase = 0;
 
     // Map ROM image into first segment
@@ -172,8 +169,7 @@ void CartridgeE7::bank(uInt16 slice)
   }
   else
   {
-    System::PageAccess access;
-    access.device = this;
+    System::PageAccess access(this);
 
     // Set the page accessing method for the 1K slice of RAM writing pages
     access.directPeekBase = 0;
@@ -214,8 +210,7 @@ void CartridgeE7::bankRAM(uInt16 bank)
   uInt16 shift = mySystem->pageShift();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
 
   // Set the page accessing method for the 256 bytes of RAM writing pages
   access.directPeekBase = 0;
@@ -63,12 +63,11 @@ void CartridgeF4::install(System& system)
   assert((0x1000 & mask) == 0);
 
   // Set the page accessing methods for the hot spots
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = (0x1FF4 & ~mask); i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
@@ -122,8 +121,7 @@ void CartridgeF4::bank(uInt16 bank)
   uInt16 mask = mySystem->pageMask();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   // Map ROM image into the system
@@ -70,19 +70,17 @@ void CartridgeF4SC::install(System& system)
   assert(((0x1080 & mask) == 0) && ((0x1100 & mask) == 0));
 
   // Set the page accessing methods for the hot spots
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = (0x1FF4 & ~mask); i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 
   // Set the page accessing method for the RAM writing pages
   for(uInt32 j = 0x1000; j < 0x1080; j += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = 0;
     access.directPokeBase = &myRAM[j & 0x007F];
     mySystem->setPageAccess(j >> shift, access);
@@ -91,7 +89,6 @@ void CartridgeF4SC::install(System& system)
   // Set the page accessing method for the RAM reading pages
   for(uInt32 k = 0x1080; k < 0x1100; k += (1 << shift))
   {
-    access.device = this;
     access.directPeekBase = &myRAM[k & 0x007F];
     access.directPokeBase = 0;
     mySystem->setPageAccess(k >> shift, access);
@@ -152,8 +149,7 @@ void CartridgeF4SC::bank(uInt16 bank)
   uInt16 mask = mySystem->pageMask();
 
   // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
   access.directPokeBase = 0;
 
   // Map ROM image into the system
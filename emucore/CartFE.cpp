@@ -60,12 +60,11 @@ void CartridgeFE::install(System& system)
   assert((0x1000 & mask) == 0);
 
   // Map all of the accesses to call peek and poke
-  System::PageAccess access;
+  System::PageAccess access(this);
   for(uInt32 i = 0x1000; i < 0x2000; i += (1 << shift))
   {
     access.directPeekBase = 0;
     access.directPokeBase = 0;
-    access.device = this;
     mySystem->setPageAccess(i >> shift, access);
   }
 }
@@ -37,6 +37,7 @@
 #include "Paddles.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RewindBuffer.hxx"
 #include "Settings.hxx" 
 #include "Sound.hxx"
 #include "Switches.hxx"
@@ -74,6 +75,7 @@ Console::Console(const uInt8* image, uInt32 size, const string& md5,
   mySwitches = 0;
   mySystem = 0;
   myEvent = 0;
+  myRewindBuffer = 0;
 
   // Attach the event subsystem to the current console
   myEvent = myOSystem->eventHandler().event();
@@ -280,6 +282,7 @@ Console::~Console()
   myOSystem->cheat().saveCheats(myProperties.get(Cartridge_MD5));
 #endif
 
+  delete myRewindBuffer;
   delete mySystem;
   delete mySwitches;
   delete myControllers[0];
@@ -500,6 +503,93 @@ void Console::fry()
     mySystem->poke(ZPmem, mySystem->peek(ZPmem) & (uInt8)rand() % 256);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Console::beginRunAhead(uInt32 frames, ScanlineListener* listener,
+                            bool blend)
+{
+  const string& md5 = myProperties.get(Cartridge_MD5);
+
+  // The sound must only hear the real frames
+  mySystem->tia().setSpeculative(true);
+
+  myRunAheadSnapshot.openMemory();
+  if(!mySystem->saveState(md5, myRunAheadSnapshot))
+  {
+    mySystem->tia().setSpeculative(false);
+    return false;
+  }
+
+  // Only the last frame is drawn, but for the one before it when the two
+  // are blended
+  for(uInt32 frame = 1; frame <= frames; ++frame)
+  {
+    bool last = (frame == frames);
+    myMediaSource->setScanlineListener(last ? listener : 0);
+    myMediaSource->setRendering(last || (blend && (frame + 1 == frames)));
+    myMediaSource->update();
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::endRunAhead()
+{
+  const string& md5 = myProperties.get(Cartridge_MD5);
+
+  myRunAheadRestore.openMemory(myRunAheadSnapshot.data(),
+                               myRunAheadSnapshot.size());
+  mySystem->loadState(md5, myRunAheadRestore);
+
+  mySystem->tia().setSpeculative(false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::saveRewindState()
+{
+  const string& md5 = myProperties.get(Cartridge_MD5);
+
+  // Keep about a minute of states, with a keyframe every second
+  if(myRewindBuffer == 0)
+    myRewindBuffer = new RewindBuffer(60 * 60, 512 * 1024, 60);
+
+  myRewindSnapshot.openMemory();
+  if(mySystem->saveState(md5, myRewindSnapshot))
+    myRewindBuffer->push(myRewindSnapshot.data(), myRewindSnapshot.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Console::rewindFrame()
+{
+  const string& md5 = myProperties.get(Cartridge_MD5);
+
+  if((myRewindBuffer == 0) || (myRewindBuffer->states() == 0))
+    return false;
+
+  // Once at the oldest state, keep showing it
+  myRewindBuffer->pop();
+
+  myRewindRestore.openMemory(myRewindBuffer->data(), myRewindBuffer->size());
+  if(!mySystem->loadState(md5, myRewindRestore))
+  {
+    myRewindBuffer->clear();
+    return false;
+  }
+
+  mySystem->tia().setSpeculative(true);
+  myMediaSource->update();
+  mySystem->tia().setSpeculative(false);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::freeRewindBuffer()
+{
+  delete myRewindBuffer;
+  myRewindBuffer = 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::changeXStart(int direction)
 {
@@ -23,6 +23,8 @@ class Console;
 class Controller;
 class Event;
 class MediaSource;
+class RewindBuffer;
+class ScanlineListener;
 class Switches;
 class System;
 
@@ -32,6 +34,8 @@ class System;
 #include "TIA.hxx"
 #include "Cart.hxx"
 #include "M6532.hxx"
+#include "Serializer.hxx"
+#include "Deserializer.hxx"
 
 /**
   This class represents the entire game console.
@@ -191,6 +195,50 @@ class Console
     */
     void fry();
 
+    /**
+      Takes a snapshot of the machine, then emulates the given number of
+      frames ahead of it with the current input so that their image can
+      be shown with less input lag.  The machine must be rolled back with
+      endRunAhead() before the next real frame is emulated.
+
+      Only the last frame is drawn, and told to the scanline listener.
+      The frame before it is also drawn if it's blended with the last one.
+
+      @param frames    The number of frames to run ahead
+      @param listener  The scanline listener of the last frame, or 0
+      @param blend     Whether the frame before the last one is drawn
+      @return True if the snapshot could be taken and frames were run
+    */
+    bool beginRunAhead(uInt32 frames, ScanlineListener* listener,
+                       bool blend);
+
+    /**
+      Rolls the machine back to the snapshot taken by beginRunAhead().
+    */
+    void endRunAhead();
+
+    /**
+      Adds the current state of the machine to the rewind buffer, which
+      is created the first time.  This should be called after every real
+      frame while rewinding is on.
+    */
+    void saveRewindState();
+
+    /**
+      Puts the machine back one frame in the rewind buffer and emulates
+      that frame again, without sound, so that it can be shown.  The
+      oldest frame is shown again once the buffer has run out.
+
+      @return False if the rewind buffer is empty
+    */
+    bool rewindFrame();
+
+    /**
+      Frees the rewind buffer and the states in it, once rewinding has
+      been switched off.
+    */
+    void freeRewindBuffer();
+
   public:
     /**
       Change the "Display.XStart" variable.  Currently, a system reset is issued
@@ -271,6 +319,15 @@ class Console
     // Indicates whether the console was correctly initialized
     // We don't really care why it wasn't initialized ...
     bool myIsInitializedFlag;
+
+    // Snapshot of the machine taken before running ahead
+    Serializer myRunAheadSnapshot;
+    Deserializer myRunAheadRestore;
+
+    // The recent states of the machine, and the objects used to get them
+    RewindBuffer* myRewindBuffer;
+    Serializer myRewindSnapshot;
+    Deserializer myRewindRestore;
 };
 
 #endif
@@ -16,10 +16,19 @@
 // $Id: Deserializer.cxx,v 1.10 2005/12/29 21:16:26 stephena Exp $
 //============================================================================
 
+#include <fstream>
+#include <string.h>
+
 #include "Deserializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Deserializer::Deserializer(void)
+  : myFileData(0),
+    myFileCapacity(0),
+    myData(0),
+    mySize(0),
+    myPosition(0),
+    myOpenFlag(false)
 {
 }
 
@@ -27,13 +36,48 @@ Deserializer::Deserializer(void)
 Deserializer::~Deserializer(void)
 {
   close();
+
+  delete[] myFileData;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Deserializer::open(const string& fileName)
 {
   close();
-  myStream.open(fileName.c_str(), ios::in | ios::binary);
+
+  ifstream in(fileName.c_str(), ios::in | ios::binary);
+  if(!in)
+    return false;
+
+  in.seekg(0, ios::end);
+  streampos length = in.tellg();
+  in.seekg(0, ios::beg);
+  if(length < 0)
+    return false;
+
+  uInt32 size = (uInt32)length;
+  if(size > myFileCapacity)
+  {
+    delete[] myFileData;
+    myFileData = new uInt8[size];
+    myFileCapacity = size;
+  }
+
+  in.read((char*)myFileData, (streamsize)size);
+  if(!in)
+    return false;
+
+  return openMemory(myFileData, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Deserializer::openMemory(const uInt8* data, uInt32 size)
+{
+  close();
+
+  myData = data;
+  mySize = size;
+  myOpenFlag = true;
 
   return isOpen();
 }
@@ -41,20 +85,22 @@ bool Deserializer::open(const string& fileName)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Deserializer::close(void)
 {
-  myStream.close();
-  myStream.clear();
+  myData = 0;
+  mySize = 0;
+  myPosition = 0;
+  myOpenFlag = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Deserializer::isOpen(void)
 {
-  return myStream.is_open();
+  return myOpenFlag;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Deserializer::getInt(void)
 {
-  if(myStream.eof()) {
+  if(myPosition + 4 > mySize) {
 # if 0 //LUDO:
     throw "Deserializer: end of file";
 # endif
@@ -62,11 +108,12 @@ int Deserializer::getInt(void)
   }
 
   int val = 0;
-  unsigned char buf[4];
-  myStream.read((char*)buf, 4);
+  const uInt8* buf = myData + myPosition;
   for(int i = 0; i < 4; ++i)
     val += (int)(buf[i]) << (i<<3);
 
+  myPosition += 4;
+
   return val;
 }
 
@@ -74,11 +121,8 @@ int Deserializer::getInt(void)
 string Deserializer::getString(void)
 {
   int len = getInt();
-  string str;
-  str.resize((string::size_type)len);
-  myStream.read(&str[0], (streamsize)len);
 
-  if(myStream.bad()) {
+  if((len < 0) || (myPosition + (uInt32)len > mySize)) {
 # if 0 //LUDO:
     throw "Deserializer: file read failed";
 # else
@@ -86,6 +130,9 @@ string Deserializer::getString(void)
 # endif
   }
 
+  string str((const char*)myData + myPosition, (string::size_type)len);
+  myPosition += len;
+
   return str;
 }
 
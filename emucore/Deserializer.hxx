@@ -19,13 +19,13 @@
 #ifndef DESERIALIZER_HXX
 #define DESERIALIZER_HXX
 
-#include <fstream>
 #include "bspf.hxx"
 
 /**
   This class implements a Deserializer device, whereby data is
   deserialized from an input binary file in a system-independent
-  way.
+  way.  The whole file is read into memory when it's opened; the
+  data can also come straight from a Serializer's memory buffer.
 
   All ints should be cast to their appropriate data type upon method
   return.
@@ -59,6 +59,17 @@ class Deserializer
     */
     bool open(const string& fileName);
 
+    /**
+      Opens the given serialized data for input.  Multiple calls to this
+      method will close previously opened files.  The data isn't copied,
+      so it must not change while the deserializer is open.
+
+      @param data The data returned by Serializer::data().
+      @param size The number of bytes returned by Serializer::size().
+      @return Result of opening the buffer, always true
+    */
+    bool openMemory(const uInt8* data, uInt32 size);
+
     /**
       Closes the current input stream.
     */
@@ -91,8 +102,17 @@ class Deserializer
     bool getBool(void);
 
   private:
-    // The stream to get the deserialized data from.
-    fstream myStream;
+    // The contents of the file opened, and the number of bytes allocated
+    uInt8* myFileData;
+    uInt32 myFileCapacity;
+
+    // The data to deserialize, its size and the position of the next read
+    const uInt8* myData;
+    uInt32 mySize;
+    uInt32 myPosition;
+
+    // Indicates whether there's anything opened
+    bool myOpenFlag;
 
     enum {
       TruePattern  = 0xfab1fab2,
@@ -18,7 +18,9 @@
 
 #include <sstream>
 #include <string.h>
+#ifndef HEADLESS
 #include <SDL/SDL.h>
+#endif
 
 #include "Event.hxx"
 #include "EventHandler.hxx"
@@ -29,7 +31,9 @@
 #include "FrameBuffer.hxx"
 #include "Sound.hxx"
 #include "OSystem.hxx"
+#ifndef HEADLESS
 # include "psp_kbd.h"
+#endif
 
 #include "GuiUtils.hxx"
 #include "Deserializer.hxx"
@@ -1288,12 +1292,15 @@ bool EventHandler::eventStateChange(Event::Type type)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EventHandler::createMouseMotionEvent(int x, int y)
 {
+#ifndef HEADLESS
   SDL_WarpMouse(x, y);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EventHandler::createMouseButtonEvent(int x, int y, int state)
 {
+#ifndef HEADLESS
   // Synthesize an left mouse button press/release event
   SDL_MouseButtonEvent mouseEvent;
   mouseEvent.type   = state ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
@@ -1303,6 +1310,7 @@ void EventHandler::createMouseButtonEvent(int x, int y, int state)
   mouseEvent.y      = y;
 
   handleMouseButtonEvent((SDL_Event&)mouseEvent, state);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
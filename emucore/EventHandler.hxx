@@ -19,7 +19,11 @@
 #ifndef EVENTHANDLER_HXX
 #define EVENTHANDLER_HXX
 
+#ifndef HEADLESS
 #include <SDL/SDL.h>
+#else
+#include "HeadlessSDL.h"
+#endif
 
 #include "bspf.hxx"
 #include "Event.hxx"
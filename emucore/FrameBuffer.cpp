@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <sstream>
+#include <errno.h>
 #include <time.h>
 
 #include "global.h"
@@ -40,9 +41,11 @@
 #endif
 
 #include "Atari.h"
+#ifndef HEADLESS
 #include "psp_sdl.h"
 #include "psp_kbd.h"
 #include "psp_danzeff.h"
+#endif
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBuffer::FrameBuffer(OSystem* osystem)
   : myOSystem(osystem),
@@ -53,6 +56,7 @@ FrameBuffer::FrameBuffer(OSystem* osystem)
     theRedrawTIAIndicator(true),
     myUsePhosphor(false),
     myPhosphorBlend(77),
+    myFlickerMode(ATARI_FLICKER_NONE),
     myFrameRate(0)
 {
   myBaseDim.x = myBaseDim.y = myBaseDim.w = myBaseDim.h = 0;
@@ -68,20 +72,14 @@ FrameBuffer::~FrameBuffer(void)
 void FrameBuffer::initialize(const string& title, uInt32 width, uInt32 height,
                              bool useAspect)
 {
-  bool isAlreadyInitialized = (SDL_WasInit(SDL_INIT_VIDEO) & SDL_INIT_VIDEO) > 0;
-
   myBaseDim.w = (uInt16) width;
   myBaseDim.h = (uInt16) height;
   myFrameRate = myOSystem->frameRate();
 
-  // Now (re)initialize the SDL video system
-  if(!isAlreadyInitialized)
-  {
-    Uint32 initflags = SDL_INIT_VIDEO | SDL_INIT_TIMER;
+  // Now (re)initialize the video system
+  if(!initVideoSystem())
+    return;
 
-    if(SDL_Init(initflags) < 0)
-      return;
-  }
   setWindowIcon();
   cls();
 
@@ -126,46 +124,102 @@ void FrameBuffer::initialize(const string& title, uInt32 width, uInt32 height,
   for(int i = 0; i < kNumColors-256; i++)
     myDefPalette[i+256] = mapRGB(ourGUIColors[i][0], ourGUIColors[i][1], ourGUIColors[i][2]);
 
-  // Enable unicode so we can see translated key events
-  // (lowercase vs. uppercase characters)
-  SDL_EnableUNICODE(1);
-
   // Erase any messages from a previous run
   myMessage.counter = 0;
 
   myUseDirtyRects = myOSystem->settings().getBool("dirtyrects");
 }
 
+// Frames are paced on an absolute deadline: the pacer sleeps until a bit
+// before it, then spins for the remaining time, which a sleep can't hit
+#define ATARI_SYNC_SPIN_NSEC   300000LL
+#define ATARI_NSEC_PER_SEC     1000000000LL
+
+// In sound mode, the frame period is stretched or shrunk (by up to 5%) to
+// keep about two frames of sound emulated ahead of the sound device
+#define ATARI_SYNC_AUDIO_FRAMES   2.0
+#define ATARI_SYNC_AUDIO_GAIN     0.02
+#define ATARI_SYNC_AUDIO_MAX      0.05
+
+static inline long long
+atari_monotonic_nsec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * ATARI_NSEC_PER_SEC + ts.tv_nsec;
+}
+
 static void
-atari_synchronize(uInt32 framerate)
+atari_sleep_until(long long deadline)
 {
-  static u32 nextclock = 1;
-  static u32 next_sec_clock = 0;
+  struct timespec ts;
+  ts.tv_sec  = deadline / ATARI_NSEC_PER_SEC;
+  ts.tv_nsec = deadline % ATARI_NSEC_PER_SEC;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+}
+
+static void
+atari_synchronize(Sound& sound)
+{
+  static long long nextclock = 0;
+  static long long next_sec_clock = 0;
+  static long long last_frame_clock = 0;
   static u32 cur_num_frame = 0;
+  static int max_jitter = 0;
 
-  u32 curclock = SDL_GetTicks();
+  long long curclock = atari_monotonic_nsec();
 
   if (ATARI.atari_speed_limiter) {
-    while (curclock < nextclock) {
-     curclock = SDL_GetTicks();
+    long long f_period = ATARI_NSEC_PER_SEC / ATARI.atari_speed_limiter;
+
+    if (ATARI.atari_sync_audio == ATARI_SYNC_SOUND) {
+      double buffered = sound.bufferedDuration();
+      if (buffered >= 0.0) {
+        double target = ATARI_SYNC_AUDIO_FRAMES / ATARI.atari_speed_limiter;
+        double ratio  = (buffered - target) * ATARI.atari_speed_limiter * ATARI_SYNC_AUDIO_GAIN;
+        if (ratio >  ATARI_SYNC_AUDIO_MAX) ratio =  ATARI_SYNC_AUDIO_MAX;
+        if (ratio < -ATARI_SYNC_AUDIO_MAX) ratio = -ATARI_SYNC_AUDIO_MAX;
+        f_period = (long long)(f_period * (1.0 + ratio));
+      }
     }
-    u32 f_period = 1000 / ATARI.atari_speed_limiter;
+
+    if (curclock < nextclock) {
+      if (nextclock - curclock > ATARI_SYNC_SPIN_NSEC) {
+        atari_sleep_until(nextclock - ATARI_SYNC_SPIN_NSEC);
+      }
+      do {
+        curclock = atari_monotonic_nsec();
+      } while (curclock < nextclock);
+    }
+
+    /* The deadline keeps its pace unless more than a frame late */
     nextclock += f_period;
     if (nextclock < curclock) nextclock = curclock + f_period;
+
+    if (last_frame_clock) {
+      int jitter = (int)((curclock - last_frame_clock - f_period) / 1000);
+      if (jitter < 0) jitter = -jitter;
+      if (jitter > max_jitter) max_jitter = jitter;
+    }
   }
+  last_frame_clock = curclock;
 
   if (ATARI.atari_view_fps) {
     cur_num_frame++;
     if (curclock > next_sec_clock) {
-      next_sec_clock = curclock + 1000;
+      next_sec_clock = curclock + ATARI_NSEC_PER_SEC;
       ATARI.atari_current_fps = cur_num_frame * (1 + ATARI.psp_skip_max_frame);
+      ATARI.atari_current_jitter = max_jitter;
       cur_num_frame = 0;
+      max_jitter = 0;
     }
   }
 }
 
+#ifndef HEADLESS
 extern "C" int psp_kbd_is_danzeff_mode();
 extern "C" int psp_screenshot_mode;
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::update()
@@ -174,7 +228,21 @@ void FrameBuffer::update()
 # if 0 //LUDO:
   preFrameUpdate();
 # endif
+#ifndef HEADLESS
   psp_update_keys();
+#endif
+
+  // The menu may have changed the flicker mode the palette was built for
+  // (the tables can't change while another thread draws with them)
+  if((ATARI.atari_flicker_mode != myFlickerMode) ||
+     ((myFlickerMode == ATARI_FLICKER_PHOSPHOR) &&
+      (ATARI.atari_flicker_blend != myPhosphorBlend)))
+  {
+#ifndef HEADLESS
+    psp_sdl_acquire_screen();
+#endif
+    setPalette(myOSystem->console().mediaSource().palette());
+  }
 
   // Determine which mode we are in (from the EventHandler)
   // Take care of S_EMULATE mode here, otherwise let the GUI
@@ -259,6 +327,27 @@ void FrameBuffer::update()
   bool mediaSourceChanged = false;
   if(!myOSystem->eventHandler().isPaused())
 # endif
+  // When running ahead, the frame shown is the last one run ahead rather
+  // than the real one.  Not while rewinding, where the frame shown is the
+  // one stepped back to.
+  bool shown = (ATARI.psp_skip_cur_frame <= 0);
+  bool runAhead = shown && (ATARI.atari_run_ahead > 0) &&
+                  !ATARI.atari_rewind_pressed;
+
+  // The frames emulated for the screen being drawn are drawn line by line
+  // as they're emulated, while the lines are still in the cache
+  myOSystem->console().mediaSource().setScanlineListener(
+      (shown && !runAhead) ? scanlineListener() : 0);
+
+  // The frames which aren't shown aren't even drawn, but for the one just
+  // before a frame shown in a flicker mode, which is blended with it
+  myOSystem->console().mediaSource().setRendering(
+      (shown && !runAhead) ||
+      (runAhead && (ATARI.atari_run_ahead == 1) && ATARI.atari_flicker_mode) ||
+      ((ATARI.psp_skip_cur_frame == 1) && ATARI.atari_flicker_mode));
+
+  // While the rewind key is held, frames are taken from the rewind buffer
+  if (! (ATARI.atari_rewind_pressed && myOSystem->console().rewindFrame()))
   {
     myOSystem->console().mediaSource().update();
     if(myOSystem->eventHandler().frying()) {
@@ -267,6 +356,11 @@ void FrameBuffer::update()
 # if 0 //LUDO:
     mediaSourceChanged = true;  // mediasource changed, so force an update
 # endif
+    if (ATARI.atari_rewind) {
+      myOSystem->console().saveRewindState();
+    } else {
+      myOSystem->console().freeRewindBuffer();
+    }
   }
 
   // Only update the screen if it's been invalidated
@@ -276,34 +370,37 @@ void FrameBuffer::update()
 # endif
 
   // We always draw the screen, even if the core is paused
-  if (ATARI.psp_skip_cur_frame <= 0) {
+  if (shown) {
 
     ATARI.psp_skip_cur_frame = ATARI.psp_skip_max_frame;
 
-    drawMediaSourceNormal(); 
+    // Show the frames that the current input will lead to, then go back
+    // to the real machine (only the frames being drawn need it)
+    if (runAhead) {
+      runAhead = myOSystem->console().beginRunAhead(ATARI.atari_run_ahead,
+                     scanlineListener(), ATARI.atari_flicker_mode != 0);
+    }
 
-    atari_synchronize(myFrameRate);
+    drawMediaSourceNormal(); 
 
-    if (psp_kbd_is_danzeff_mode()) {
-      danzeff_moveTo(-10, -65);
-      danzeff_render();
+    if (runAhead) {
+      myOSystem->console().endRunAhead();
     }
 
-    if (ATARI.atari_view_fps) {
-      char buffer[32];
-      sprintf(buffer, "%03d %3d", ATARI.atari_current_clock, (int)ATARI.atari_current_fps );
-      psp_sdl_fill_print(0, 0, buffer, 0xffffff, 0 );
-    }
+    atari_synchronize(myOSystem->sound());
 
-    psp_sdl_flip();
+    showFrame();
   
+#ifndef HEADLESS
     if (psp_screenshot_mode) {
       psp_screenshot_mode--;
       if (psp_screenshot_mode <= 0) {
+        psp_sdl_acquire_screen();
         psp_sdl_save_screenshot();
         psp_screenshot_mode = 0;
       }
     }
+#endif
   } else if (ATARI.psp_skip_max_frame) {
     ATARI.psp_skip_cur_frame--;
   }
@@ -325,6 +422,51 @@ void FrameBuffer::update()
 # endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::showFrame()
+{
+  drawOverlays();
+
+  // Only flips the lines that changed
+  postFrameUpdate();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::drawOverlays()
+{
+#ifndef HEADLESS
+  if (psp_kbd_is_danzeff_mode()) {
+    danzeff_moveTo(-10, -65);
+    danzeff_render();
+
+    // The keyboard is drawn over the game, so it's redrawn next frame
+    psp_sdl_full_update = 1;
+  }
+
+  if (ATARI.atari_view_fps) {
+    char buffer[FRAMEBUFFER_FPS_SIZE];
+    formatFps(buffer);
+    drawFps(buffer);
+  }
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::formatFps(char* buffer)
+{
+  snprintf(buffer, FRAMEBUFFER_FPS_SIZE, "%03d %3d %4d",
+           ATARI.atari_current_clock, (int)ATARI.atari_current_fps,
+           ATARI.atari_current_jitter);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::drawFps(const char* text)
+{
+#ifndef HEADLESS
+  psp_sdl_fill_print(0, 0, text, 0xffffff, 0);
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::showMessage(const string& message, MessagePosition position,
                               int color)
@@ -449,25 +591,51 @@ void FrameBuffer::setPalette(const uInt32* palette)
     Uint8 b = (Uint8) (palette[i] & 0x000000ff);
 
     myDefPalette[i] = mapRGB(r, g, b);
+    myDoubledPalette[i] = (myDefPalette[i] << 16) | (myDefPalette[i] & 0xffff);
   }
 
-  // Set palette for phosphor effect
-  for(i = 0; i < 256; ++i)
+  // Set palette for the flicker mode, indexed by the current frame's pixel
+  // then the previous frame's
+  myFlickerMode   = ATARI.atari_flicker_mode;
+  myPhosphorBlend = ATARI.atari_flicker_blend;
+
+  if(myFlickerMode != ATARI_FLICKER_NONE)
   {
-    for(j = 0; j < 256; ++j)
+    for(i = 0; i < 256; ++i)
     {
-      uInt8 ri = (uInt8) ((palette[i] & 0x00ff0000) >> 16);
-      uInt8 gi = (uInt8) ((palette[i] & 0x0000ff00) >> 8);
-      uInt8 bi = (uInt8) (palette[i] & 0x000000ff);
-      uInt8 rj = (uInt8) ((palette[j] & 0x00ff0000) >> 16);
-      uInt8 gj = (uInt8) ((palette[j] & 0x0000ff00) >> 8);
-      uInt8 bj = (uInt8) (palette[j] & 0x000000ff);
-
-      Uint8 r = (Uint8) getPhosphor(ri, rj);
-      Uint8 g = (Uint8) getPhosphor(gi, gj);
-      Uint8 b = (Uint8) getPhosphor(bi, bj);
-
-      myAvgPalette[i][j] = mapRGB(r, g, b);
+      for(j = 0; j < 256; ++j)
+      {
+        // Simple mode shows the previous frame where the current one is black
+        if(myFlickerMode == ATARI_FLICKER_SIMPLE)
+        {
+          myFlickerPalette[i][j] = myDoubledPalette[i ? i : j];
+          continue;
+        }
+
+        uInt8 ri = (uInt8) ((palette[i] & 0x00ff0000) >> 16);
+        uInt8 gi = (uInt8) ((palette[i] & 0x0000ff00) >> 8);
+        uInt8 bi = (uInt8) (palette[i] & 0x000000ff);
+        uInt8 rj = (uInt8) ((palette[j] & 0x00ff0000) >> 16);
+        uInt8 gj = (uInt8) ((palette[j] & 0x0000ff00) >> 8);
+        uInt8 bj = (uInt8) (palette[j] & 0x000000ff);
+
+        Uint8 r, g, b;
+        if(myFlickerMode == ATARI_FLICKER_PHOSPHOR)
+        {
+          r = (Uint8) getPhosphor(ri, rj);
+          g = (Uint8) getPhosphor(gi, gj);
+          b = (Uint8) getPhosphor(bi, bj);
+        }
+        else
+        {
+          r = (Uint8) ((ri + rj) >> 1);
+          g = (Uint8) ((gi + gj) >> 1);
+          b = (Uint8) ((bi + bj) >> 1);
+        }
+
+        uInt32 color = mapRGB(r, g, b);
+        myFlickerPalette[i][j] = (color << 16) | (color & 0xffff);
+      }
     }
   }
 
@@ -19,7 +19,11 @@
 #ifndef FRAMEBUFFER_HXX
 #define FRAMEBUFFER_HXX
 
+#ifndef HEADLESS
 #include <SDL/SDL.h>
+#else
+#include "HeadlessSDL.h"
+#endif
 
 #include "bspf.hxx"
 #include "Event.hxx"
@@ -29,6 +33,9 @@
 # endif
 #include "GuiUtils.hxx"
 
+// Size of the fps counter printed over the game
+#define FRAMEBUFFER_FPS_SIZE  32
+
 class OSystem;
 class Console;
 
@@ -298,6 +305,13 @@ class FrameBuffer
     // The following methods are system-specific and must be implemented
     // in derived classes.
     //////////////////////////////////////////////////////////////////////
+    /**
+      This method is called to bring up the video system the framebuffer
+      draws with, before anything else is done with it.
+      Return false if it isn't available.
+    */
+    virtual bool initVideoSystem() = 0;
+
     /**
       This method is called to initialize the subsystem-specific video mode.
     */
@@ -335,6 +349,35 @@ class FrameBuffer
     virtual void drawMediaSourceBlitSurface(uInt32 pitch, uInt16* buffer) = 0;
 # endif
 
+    /**
+      Answers the object which draws the scanlines of the media source to
+      the screen as soon as they're emulated, if this framebuffer has one.
+    */
+    virtual ScanlineListener* scanlineListener() { return 0; }
+
+    /**
+      Draws what goes over the game and shows the frame drawn by
+      drawMediaSourceNormal().  Framebuffers which show the frames from
+      another thread hand it over instead.
+    */
+    virtual void showFrame();
+
+    /**
+      Draws the virtual keyboard and the fps counter over the game.
+    */
+    void drawOverlays();
+
+    /**
+      Writes the fps counter into the given buffer, of at least
+      FRAMEBUFFER_FPS_SIZE characters.
+    */
+    void formatFps(char* buffer);
+
+    /**
+      Prints the given fps counter over the top of the screen.
+    */
+    void drawFps(const char* text);
+
     /**
       This method is called before any drawing is done (per-frame).
     */
@@ -475,9 +518,17 @@ class FrameBuffer
     // SDL initialization flags
     uInt32 mySDLFlags;
 
-    // TIA palettes for normal and phosphor modes
+    // TIA palette for normal mode
     Uint32 myDefPalette[256+kNumColors];
-    Uint32 myAvgPalette[256][256];
+
+    // The normal palette with each 16-bit colour in both halves, so that
+    // a doubled pixel is written with a single 32-bit store
+    uInt32 myDoubledPalette[256];
+
+    // The doubled colour shown for each pair of current and previous frame
+    // pixels in the flicker mode it was built for
+    uInt32 myFlickerPalette[256][256];
+    int myFlickerMode;
 
     // Indicates the current zoom level of the SDL screen
     uInt32 theZoomLevel;
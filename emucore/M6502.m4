@@ -155,7 +155,9 @@ define(M6502_BIT, `{
   V = operand & 0x40;
 }')
 
-define(M6502_BRK, `{
+dnl The low compatibility CPU defines its own BRK and JSR (its operands are
+dnl fetched before the instruction runs)
+ifdef(`M6502_BRK', , `define(`M6502_BRK', `{
   peek(PC++);
 
   B = true;
@@ -168,7 +170,7 @@ define(M6502_BRK, `{
 
   PC = peek(0xfffe);
   PC |= ((uInt16)peek(0xffff) << 8);
-}')
+}')')
 
 define(M6502_CLC, `{
   C = false;
@@ -308,7 +310,7 @@ define(M6502_JMP, `{
   PC = operandAddress;
 }')
 
-define(M6502_JSR, `{
+ifdef(`M6502_JSR', , `define(`M6502_JSR', `{
   uInt8 low = peek(PC++);
   peek(0x0100 + SP);
 
@@ -319,7 +321,7 @@ define(M6502_JSR, `{
   poke(0x0100 + SP--, PC & 0xff);
 
   PC = low | ((uInt16)peek(PC++) << 8); 
-}')
+}')')
 
 define(M6502_LAS, `{
   A = X = SP = SP & operand;
@@ -28,16 +28,173 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502Low::M6502Low(uInt32 systemCyclesPerProcessorCycle)
-    : M6502(systemCyclesPerProcessorCycle)
+    : M6502(systemCyclesPerProcessorCycle),
+      myDecodeCache(0),
+      myCodePageBase(0),
+      myCodePageChecked(0),
+      myCodeAddressMask(0),
+      myCodePageShift(0),
+      myCodePageMask(0)
 {
 #ifdef DEVELOPER_SUPPORT
   myJustHitTrapFlag = false;
 #endif
+
+  // Work out how many operand bytes each instruction handler expects
+  for(uInt32 t = 0; t < 256; ++t)
+  {
+    switch(ourAddressingModeTable[t])
+    {
+      case Absolute:
+      case AbsoluteX:
+      case AbsoluteY:
+      case Indirect:
+        myOperandLengthTable[t] = 2;
+        break;
+
+      case Immediate:
+      case IndirectX:
+      case IndirectY:
+      case Relative:
+      case Zero:
+      case ZeroX:
+      case ZeroY:
+        myOperandLengthTable[t] = 1;
+        break;
+
+      default:
+        myOperandLengthTable[t] = 0;
+        break;
+    }
+  }
+
+  // BRK skips the byte following it
+  myOperandLengthTable[0x00] = 1;
+
+  myUncachedInstruction.code = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502Low::~M6502Low()
 {
+  if(mySystem != 0)
+    mySystem->removePageAccessObserver(this);
+
+  delete[] myDecodeCache;
+  delete[] myCodePageBase;
+  delete[] myCodePageChecked;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502Low::install(System& system)
+{
+  M6502::install(system);
+
+  uInt32 pages = mySystem->numberOfPages();
+  uInt32 size = pages << mySystem->pageShift();
+
+  myCodeAddressMask = size - 1;
+  myCodePageShift = mySystem->pageShift();
+  myCodePageMask = mySystem->pageMask();
+
+  delete[] myDecodeCache;
+  delete[] myCodePageBase;
+  delete[] myCodePageChecked;
+
+  myDecodeCache = new DecodedInstruction[size];
+  myCodePageBase = new const uInt8*[pages];
+  myCodePageChecked = new bool[pages];
+
+  flushDecodeCache();
+
+  // Find out about bank switching and cheats from now on
+  mySystem->addPageAccessObserver(this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502Low::flushDecodeCache()
+{
+  uInt32 pages = mySystem->numberOfPages();
+
+  for(uInt32 i = 0; i <= myCodeAddressMask; ++i)
+    myDecodeCache[i].code = 0;
+
+  for(uInt32 page = 0; page < pages; ++page)
+  {
+    myCodePageBase[page] = 0;
+    myCodePageChecked[page] = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502Low::pageAccessChanged(uInt16 page)
+{
+  // When a page becomes writable other pages looking at the same memory
+  // can't be cached anymore, so check all of them again
+  if(mySystem->getPageAccess(page).directPokeBase != 0)
+  {
+    for(uInt32 i = 0; i < mySystem->numberOfPages(); ++i)
+      myCodePageChecked[i] = false;
+  }
+  else
+  {
+    myCodePageChecked[page] = false;
+  }
+
+  // The decoded instructions of this page are tagged with the address
+  // they were read from, so they can't be mistaken for the new ones.
+  // Instructions at the end of the previous page may have operands on
+  // this one though.
+  uInt16 address = (uInt16)(page << myCodePageShift);
+  myDecodeCache[(address - 1) & myCodeAddressMask].code = 0;
+  myDecodeCache[(address - 2) & myCodeAddressMask].code = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502Low::memoryChanged(uInt16 address)
+{
+  uInt16 page = (uInt16)((address & myCodeAddressMask) >> myCodePageShift);
+  const uInt8* base = mySystem->getPageAccess(page).directPeekBase;
+  if(base == 0)
+  {
+    flushDecodeCache();
+    return;
+  }
+
+  // The byte may be mirrored at other addresses (i.e. a 2K cartridge is
+  // seen twice in its 4K slot), so drop any instruction the byte could
+  // be part of by where it was read from, not by its address
+  const uInt8* changed = base + (address & myCodePageMask);
+  for(uInt32 i = 0; i <= myCodeAddressMask; ++i)
+  {
+    const uInt8* code = myDecodeCache[i].code;
+    if((code != 0) && (code <= changed) && (changed - code <= 2))
+      myDecodeCache[i].code = 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* M6502Low::checkCodePage(uInt16 page)
+{
+  const uInt8* base = mySystem->getPageAccess(page).directPeekBase;
+  uInt32 pages = mySystem->numberOfPages();
+  uInt32 pageSize = myCodePageMask + 1;
+
+  // Instructions can't be cached if any page writes to the same memory
+  for(uInt32 i = 0; (base != 0) && (i < pages); ++i)
+  {
+    const uInt8* pokeBase = mySystem->getPageAccess(i).directPokeBase;
+    if((pokeBase != 0) && (pokeBase < base + pageSize) &&
+       (base < pokeBase + pageSize))
+    {
+      base = 0;
+    }
+  }
+
+  myCodePageBase[page] = base;
+  myCodePageChecked[page] = true;
+
+  return base;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -149,6 +306,8 @@ lab_0xf8, && lab_0xf9, && lab_0xfa, && lab_0xfb, && lab_0xfc, && lab_0xfd, && la
   {
     uInt16 operandAddress = 0;
     uInt8 operand = 0;
+    uInt16 decodedOperand = 0;
+    DecodedInstruction* instruction;
 
     goto begin;
 
@@ -189,8 +348,72 @@ begin:
       debugStream << "PC=" << hex << setw(4) << PC << " ";
 #endif
 
-      // Fetch instruction at the program counter
-      IR = peek(PC++);
+      // Fetch the instruction at the program counter, from the decode
+      // cache if its page can be cached
+      {
+        uInt16 page = (PC & myCodeAddressMask) >> myCodePageShift;
+        const uInt8* base = myCodePageChecked[page] ?
+            myCodePageBase[page] : checkCodePage(page);
+
+        instruction = &myUncachedInstruction;
+
+        if(base != 0)
+        {
+          const uInt8* code = base + (PC & myCodePageMask);
+          instruction = &myDecodeCache[PC & myCodeAddressMask];
+
+          if(instruction->code != code)
+          {
+            uInt8 opcode = *code;
+            uInt8 length = myOperandLengthTable[opcode];
+
+            // The operand bytes have to be read from the same memory, so
+            // an instruction running into another page can only be cached
+            // if that page follows this one in memory
+            uInt16 last = (PC + length) & myCodeAddressMask;
+            uInt16 lastPage = last >> myCodePageShift;
+            if((lastPage != page) &&
+               ((myCodePageChecked[lastPage] ? myCodePageBase[lastPage] :
+                 checkCodePage(lastPage)) != base + myCodePageMask + 1))
+            {
+              instruction = &myUncachedInstruction;
+            }
+            else
+            {
+              instruction->code = code;
+              instruction->handler = a_jump_table[opcode];
+              instruction->cycles = myInstructionSystemCycleTable[opcode];
+              instruction->opcode = opcode;
+              instruction->length = length + 1;
+              instruction->operand = (length > 0) ? code[1] : 0;
+              if(length > 1)
+                instruction->operand |= (uInt16)code[2] << 8;
+              instruction->lastByte = code[length];
+            }
+          }
+
+          // Leave the data bus as peeking the instruction would have
+          mySystem->setDataBusState(instruction->lastByte);
+        }
+
+        if(instruction == &myUncachedInstruction)
+        {
+          uInt8 opcode = peek(PC);
+          uInt8 length = myOperandLengthTable[opcode];
+
+          instruction->handler = a_jump_table[opcode];
+          instruction->cycles = myInstructionSystemCycleTable[opcode];
+          instruction->opcode = opcode;
+          instruction->length = length + 1;
+          instruction->operand = (length > 0) ? peek(PC + 1) : 0;
+          if(length > 1)
+            instruction->operand |= (uInt16)peek(PC + 2) << 8;
+        }
+      }
+
+      IR = instruction->opcode;
+      PC += instruction->length;
+      decodedOperand = instruction->operand;
 
 #ifdef DEBUG
       debugStream << "IR=" << hex << setw(2) << (int)IR << " ";
@@ -198,10 +421,10 @@ begin:
 #endif
 
       // Update system cycles
-      mySystem->incrementCycles(myInstructionSystemCycleTable[IR]); 
+      mySystem->incrementCycles(instruction->cycles); 
 
       // Call code to execute the instruction
-	    goto *a_jump_table[IR];
+      goto *instruction->handler;
       // 6502 instruction emulation is generated by an M4 macro file
       #include "M6502Low.ins"
 
@@ -25,6 +25,7 @@ class Deserializer;
 
 #include "bspf.hxx"
 #include "M6502.hxx"
+#include "System.hxx"
 
 /**
   This class provides a low compatibility 6502 microprocessor emulator.  
@@ -39,11 +40,17 @@ class Deserializer;
 
   If speed is the most important issue then use this class, however, if 
   better compatibility is neccessary use one of the other 6502 classes.
+
+  Instructions fetched from ROM (pages with a direct peek base that no
+  page can write to) are decoded once and kept in a cache indexed by
+  address, so running them again costs no peeks for the opcode and
+  operand bytes.  The processor observes the system's page access
+  table to find out when cached instructions have to be dropped.
   
   @author  Bradford W. Mott
   @version $Id: M6502Low.hxx,v 1.5 2006/02/05 02:49:47 stephena Exp $
 */
-class M6502Low : public M6502
+class M6502Low : public M6502, public System::PageAccessObserver
 {
   public:
     /**
@@ -59,6 +66,31 @@ class M6502Low : public M6502
     */
     virtual ~M6502Low();
 
+  public:
+    /**
+      Install the processor in the specified system.  Invoked by the
+      system when the processor is attached to it.
+
+      @param system The system the processor should install itself in
+    */
+    virtual void install(System& system);
+
+    /**
+      Drop the decoded instructions which may have been fetched through
+      the specified page.
+
+      @param page The page whose access methods have changed
+    */
+    virtual void pageAccessChanged(uInt16 page);
+
+    /**
+      Drop the decoded instructions which contain the byte at the
+      specified address, at any of the addresses the byte is seen at.
+
+      @param address The address of the byte which has changed
+    */
+    virtual void memoryChanged(uInt16 address);
+
   public:
     /**
       Execute instructions until the specified number of instructions
@@ -114,6 +146,66 @@ class M6502Low : public M6502
       @param value The value to be stored at the address
     */
     inline void poke(uInt16 address, uInt8 value);
+
+  private:
+    /**
+      Answer the base address of the specified page if instructions
+      fetched through it can be cached, or the null pointer if not (the
+      page isn't directly peeked or its memory is writable).
+    */
+    const uInt8* checkCodePage(uInt16 page);
+
+    /**
+      Drop all of the decoded instructions and forget what is known
+      about the pages
+    */
+    void flushDecodeCache();
+
+  private:
+    /**
+      An instruction as decoded by execute()
+    */
+    struct DecodedInstruction
+    {
+      // Where the opcode was read from, or the null pointer if unused
+      const uInt8* code;
+
+      // Address of the code executing the instruction
+      const void* handler;
+
+      // Operand bytes, low byte first
+      uInt16 operand;
+
+      // System cycles used by the instruction
+      uInt16 cycles;
+
+      // The opcode and the number of bytes of the instruction
+      uInt8 opcode;
+      uInt8 length;
+
+      // The last byte of the instruction, left on the data bus
+      uInt8 lastByte;
+    };
+
+    // Decoded instructions indexed by address
+    DecodedInstruction* myDecodeCache;
+
+    // Instruction decoded from a page which can't be cached
+    DecodedInstruction myUncachedInstruction;
+
+    // Base address of each page if it can be cached, or the null pointer
+    const uInt8** myCodePageBase;
+
+    // Indicates if the entry in myCodePageBase is up to date
+    bool* myCodePageChecked;
+
+    // Address mask, page shift and page mask of the system
+    uInt16 myCodeAddressMask;
+    uInt16 myCodePageShift;
+    uInt16 myCodePageMask;
+
+    // Number of operand bytes following each opcode
+    uInt8 myOperandLengthTable[256];
 };
 #endif
 
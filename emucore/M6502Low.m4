@@ -20,6 +20,10 @@
   Code to handle addressing modes and branch instructions for
   low compatibility emulation
 
+  The instruction has already been fetched by M6502Low::execute: PC
+  points to the next instruction and the operand bytes are in
+  decodedOperand (low byte first).
+
   @author  Bradford W. Mott
   @version $Id: M6502Low.m4,v 1.4 2006/02/05 02:49:47 stephena Exp $
 */
@@ -32,30 +36,26 @@ define(M6502_IMPLIED, `{
 }')
 
 define(M6502_IMMEDIATE_READ, `{
-  operandAddress = PC++;
-  operand = peek(operandAddress);
+  operandAddress = PC - 1;
+  operand = (uInt8)decodedOperand;
 }')
 
 define(M6502_ABSOLUTE_READ, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ABSOLUTE_WRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
 }')
 
 define(M6502_ABSOLUTE_READMODIFYWRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ABSOLUTEX_READ, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
 
   // See if we need to add one cycle for indexing across a page boundary
   if(NOTSAMEPAGE(operandAddress, operandAddress + X))
@@ -68,21 +68,18 @@ define(M6502_ABSOLUTEX_READ, `{
 }')
 
 define(M6502_ABSOLUTEX_WRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operandAddress += X; 
 }')
 
 define(M6502_ABSOLUTEX_READMODIFYWRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operandAddress += X;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ABSOLUTEY_READ, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
 
   // See if we need to add one cycle for indexing across a page boundary
   if(NOTSAMEPAGE(operandAddress, operandAddress + Y))
@@ -95,63 +92,60 @@ define(M6502_ABSOLUTEY_READ, `{
 }')
 
 define(M6502_ABSOLUTEY_WRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operandAddress += Y; 
 }')
 
 define(M6502_ABSOLUTEY_READMODIFYWRITE, `{
-  operandAddress = (uInt16)peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  operandAddress = decodedOperand;
   operandAddress += Y;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ZERO_READ, `{
-  operandAddress = peek(PC++);
+  operandAddress = decodedOperand;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ZERO_WRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = decodedOperand;
 }')
 
 define(M6502_ZERO_READMODIFYWRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = decodedOperand;
   operand = peek(operandAddress);
 }')
 
 define(M6502_ZEROX_READ, `{
-  operandAddress = (uInt8)(peek(PC++) + X);
+  operandAddress = (uInt8)(decodedOperand + X);
   operand = peek(operandAddress); 
 }')
 
 define(M6502_ZEROX_WRITE, `{
-  operandAddress = (uInt8)(peek(PC++) + X);
+  operandAddress = (uInt8)(decodedOperand + X);
 }')
 
 define(M6502_ZEROX_READMODIFYWRITE, `{
-  operandAddress = (uInt8)(peek(PC++) + X);
+  operandAddress = (uInt8)(decodedOperand + X);
   operand = peek(operandAddress);
 }')
 
 define(M6502_ZEROY_READ, `{
-  operandAddress = (uInt8)(peek(PC++) + Y);
+  operandAddress = (uInt8)(decodedOperand + Y);
   operand = peek(operandAddress); 
 }')
 
 define(M6502_ZEROY_WRITE, `{
-  operandAddress = (uInt8)(peek(PC++) + Y);
+  operandAddress = (uInt8)(decodedOperand + Y);
 }')
 
 define(M6502_ZEROY_READMODIFYWRITE, `{
-  operandAddress = (uInt8)(peek(PC++) + Y);
+  operandAddress = (uInt8)(decodedOperand + Y);
   operand = peek(operandAddress);
 }')
 
 define(M6502_INDIRECT, `{
-  uInt16 addr = peek(PC) | ((uInt16)peek(PC + 1) << 8);
-  PC += 2;
+  uInt16 addr = decodedOperand;
 
   // Simulate the error in the indirect addressing mode!
   uInt16 high = NOTSAMEPAGE(addr, addr + 1) ? (addr & 0xff00) : (addr + 1);
@@ -160,24 +154,24 @@ define(M6502_INDIRECT, `{
 }')
 
 define(M6502_INDIRECTX_READ, `{
-  uInt8 pointer = peek(PC++) + X;
+  uInt8 pointer = decodedOperand + X;
   operandAddress = peek(pointer) | ((uInt16)peek(pointer + 1) << 8);
   operand = peek(operandAddress);
 }')
 
 define(M6502_INDIRECTX_WRITE, `{
-  uInt8 pointer = peek(PC++) + X;
+  uInt8 pointer = decodedOperand + X;
   operandAddress = peek(pointer) | ((uInt16)peek(pointer + 1) << 8);
 }')
 
 define(M6502_INDIRECTX_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++) + X;
+  uInt8 pointer = decodedOperand + X;
   operandAddress = peek(pointer) | ((uInt16)peek(pointer + 1) << 8);
   operand = peek(operandAddress);
 }')
 
 define(M6502_INDIRECTY_READ, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = decodedOperand;
   operandAddress = (uInt16)peek(pointer) | ((uInt16)peek(pointer + 1) << 8); 
 
   if(NOTSAMEPAGE(operandAddress, operandAddress + Y))
@@ -190,13 +184,13 @@ define(M6502_INDIRECTY_READ, `{
 }')
 
 define(M6502_INDIRECTY_WRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = decodedOperand;
   operandAddress = (uInt16)peek(pointer) | ((uInt16)peek(pointer + 1) << 8); 
   operandAddress += Y;
 }')
 
 define(M6502_INDIRECTY_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = decodedOperand;
   operandAddress = (uInt16)peek(pointer) | ((uInt16)peek(pointer + 1) << 8); 
   operandAddress += Y;
   operand = peek(operandAddress);
@@ -283,4 +277,28 @@ define(M6502_BVS, `{
   }
 }')
 
+define(M6502_BRK, `{
+  B = true;
+
+  poke(0x0100 + SP--, PC >> 8);
+  poke(0x0100 + SP--, PC & 0x00ff);
+  poke(0x0100 + SP--, PS());
+
+  I = true;
+
+  PC = peek(0xfffe);
+  PC |= ((uInt16)peek(0xffff) << 8);
+}')
+
+define(M6502_JSR, `{
+  peek(0x0100 + SP);
+
+  // It seems that the 650x does not push the address of the next instruction
+  // on the stack it actually pushes the address of the next instruction
+  // minus one.  This is compensated for in the RTS instruction
+  poke(0x0100 + SP--, (PC - 1) >> 8);
+  poke(0x0100 + SP--, (PC - 1) & 0xff);
+
+  PC = decodedOperand;
+}')
 
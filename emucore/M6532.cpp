@@ -91,8 +91,7 @@ void M6532::install(System& system)
   assert((0x1080 & mask) == 0);
   
   // All accesses are to this device
-  System::PageAccess access;
-  access.device = this;
+  System::PageAccess access(this);
 
   // We're installing in a 2600 system
   for(int address = 0; address < 8192; address += (1 << shift))
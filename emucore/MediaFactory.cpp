@@ -25,12 +25,15 @@
 #include "OSystem.hxx"
 
 #include "FrameBuffer.hxx"
-#include "FrameBufferSoft.hxx"
+#ifndef HEADLESS
+  #include "FrameBufferSoft.hxx"
+#endif
+#include "FrameBufferNull.hxx"
 #ifdef DISPLAY_OPENGL
   #include "FrameBufferGL.hxx"
 #endif
 
-#if defined(PSP)
+#if defined(PSP) && !defined(HEADLESS)
   #include "FrameBufferPSP.hxx"
 #elif defined (_WIN32_WCE)
   #include "FrameBufferWinCE.hxx"
@@ -49,8 +52,16 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBuffer* MediaFactory::createVideo(OSystem* osystem)
 {
+#ifdef HEADLESS
+  // Without SDL, there is only the framebuffer that never draws anything
+  return new FrameBufferNull(osystem);
+#else
   FrameBuffer* fb = (FrameBuffer*) NULL;
 
+  // The headless benchmark asks for a framebuffer that never draws anything
+  if(osystem->settings().getString("video") == "null")
+    return new FrameBufferNull(osystem);
+
   // OpenGL mode *may* fail, so we check for it first
 #ifdef DISPLAY_OPENGL
   if(osystem->settings().getString("video") == "gl")
@@ -95,6 +106,7 @@ FrameBuffer* MediaFactory::createVideo(OSystem* osystem)
 # endif
 
   return fb;
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -103,6 +115,9 @@ Sound* MediaFactory::createAudio(OSystem* osystem)
   Sound* sound = (Sound*) NULL;
 
 #ifdef SOUND_SUPPORT
+  if(!osystem->settings().getBool("sound"))
+    sound = new SoundNull(osystem);
+  else
   #if defined (_WIN32_WCE)
     sound = new SoundWinCE(osystem);
   #else
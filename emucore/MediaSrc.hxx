@@ -22,6 +22,7 @@
 #include <string>
 
 class MediaSource;
+class ScanlineListener;
 class Sound;
 
 #include "bspf.hxx"
@@ -122,11 +123,37 @@ class MediaSource
     */
     virtual uInt32 scanlines() const = 0;
 
+    /**
+      Answers whether the last update() stopped before the frame
+      was finished.
+
+      @return True if the current frame is incomplete
+    */
+    virtual bool partialFrame() const = 0;
+
     /**
       Sets the sound device for the TIA.
     */
     virtual void setSound(Sound& sound) = 0;
 
+    /**
+      Sets the object told about each scanline of the current frame buffer
+      as soon as it's drawn.
+
+      @param listener  The listener, or 0 for none
+    */
+    virtual void setScanlineListener(ScanlineListener* listener) = 0;
+
+    /**
+      Sets whether the frames are drawn.  A frame which won't be shown can
+      be emulated without drawing it: the collisions, timing and registers
+      are the same, but the frame buffers are left as they were and the
+      scanline listener isn't told about any scanline.
+
+      @param enable  Whether the frames are drawn from the next update on
+    */
+    virtual void setRendering(bool enable) = 0;
+
   private:
     // Copy constructor isn't supported by this class so make it private
     MediaSource(const MediaSource&);
@@ -135,4 +162,34 @@ class MediaSource
     MediaSource& operator = (const MediaSource&);
 };
 
+/**
+  This class is told about the scanlines of the current frame buffer while
+  the media source draws them, so that they can be used while they're
+  still in the cache rather than all at once when the frame is done.
+*/
+class ScanlineListener
+{
+  public:
+    /**
+      Destructor
+    */
+    virtual ~ScanlineListener() { }
+
+  public:
+    /**
+      A scanline of the current frame buffer has been drawn.
+
+      @param line  The scanline, from the top of the frame buffer
+    */
+    virtual void scanlineDrawn(uInt32 line) = 0;
+
+    /**
+      The frame is finished.  The scanlines from the given one on weren't
+      drawn, since the frame ended early, and still hold an older frame.
+
+      @param lines  The number of scanlines drawn
+    */
+    virtual void frameDrawn(uInt32 lines) = 0;
+};
+
 #endif
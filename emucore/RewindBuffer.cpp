@@ -0,0 +1,288 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <string.h>
+
+#include "RewindBuffer.hxx"
+
+// The encoded data is a sequence of runs, each starting with a control
+// byte: 1nnnnnnn stands for n+1 zero bytes, 0nnnnnnn is followed by n+1
+// literal bytes
+#define REWIND_ZERO_RUN   0x80
+#define REWIND_MAX_RUN    128
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline uInt8 sourceByte(const uInt8* data, const uInt8* reference,
+                               uInt32 i)
+{
+  return reference ? (data[i] ^ reference[i]) : data[i];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindBuffer::RewindBuffer(uInt32 states, uInt32 size, uInt32 keyframe)
+  : myMaxRecords(states),
+    myFirst(0),
+    myCount(0),
+    myDataSize(size),
+    myKeyframeInterval(keyframe),
+    myRecordsSinceKeyframe(0),
+    myState(0),
+    myStateSize(0),
+    myStateCapacity(0),
+    myScratch(0),
+    myScratchCapacity(0)
+{
+  myRecords = new Record[myMaxRecords];
+  myData = new uInt8[myDataSize];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindBuffer::~RewindBuffer()
+{
+  delete[] myRecords;
+  delete[] myData;
+  delete[] myState;
+  delete[] myScratch;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::push(const uInt8* data, uInt32 size)
+{
+  // A state of another size can't be a difference with the newest one
+  bool keyframe = (myCount == 0) || (size != myStateSize) ||
+                  (myRecordsSinceKeyframe + 1 >= myKeyframeInterval);
+
+  if(size > myStateCapacity)
+  {
+    delete[] myState;
+    myState = new uInt8[size];
+    myStateCapacity = size;
+  }
+
+  uInt32 length = encode(data, keyframe ? 0 : myState, size);
+  uInt32 offset = 0;
+  bool fits = allocate(length, offset);
+
+  // Making room may have dropped the state this one is a difference with
+  if(fits && !keyframe && (myCount == 0))
+  {
+    keyframe = true;
+    length = encode(data, 0, size);
+    fits = allocate(length, offset);
+  }
+
+  if(!fits)
+  {
+    clear();
+    return;
+  }
+
+  memcpy(myData + offset, myScratch, length);
+
+  Record& newest = record(myCount++);
+  newest.offset = offset;
+  newest.length = length;
+  newest.stateSize = size;
+  newest.keyframe = keyframe;
+
+  myRecordsSinceKeyframe = keyframe ? 0 : myRecordsSinceKeyframe + 1;
+
+  memcpy(myState, data, size);
+  myStateSize = size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindBuffer::pop()
+{
+  if(myCount < 2)
+    return false;
+
+  Record newest = record(--myCount);
+
+  if(!newest.keyframe)
+  {
+    // Applying the difference once more gives the state before it
+    decode(newest);
+    --myRecordsSinceKeyframe;
+  }
+  else
+  {
+    // The state before a keyframe has to be rebuilt from the previous one
+    uInt32 keyframe = myCount - 1;
+    while(!record(keyframe).keyframe)
+      --keyframe;
+
+    for(uInt32 i = keyframe; i < myCount; ++i)
+      decode(record(i));
+
+    myRecordsSinceKeyframe = myCount - 1 - keyframe;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::clear()
+{
+  myFirst = 0;
+  myCount = 0;
+  myRecordsSinceKeyframe = 0;
+  myStateSize = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 RewindBuffer::encode(const uInt8* data, const uInt8* reference,
+                            uInt32 size)
+{
+  // Zero runs are at least two bytes long (except at the very end), so
+  // the worst case is one control byte for every run of literals
+  uInt32 worst = size + size / REWIND_MAX_RUN + 2;
+  if(worst > myScratchCapacity)
+  {
+    delete[] myScratch;
+    myScratch = new uInt8[worst];
+    myScratchCapacity = worst;
+  }
+
+  uInt8* out = myScratch;
+  uInt32 i = 0;
+
+  while(i < size)
+  {
+    uInt32 count = 0;
+    while((i + count < size) && (count < REWIND_MAX_RUN) &&
+          (sourceByte(data, reference, i + count) == 0))
+      ++count;
+
+    if(count > 0)
+    {
+      *out++ = REWIND_ZERO_RUN | (count - 1);
+      i += count;
+      continue;
+    }
+
+    // Literal bytes, up to the next pair of zeros
+    uInt8* control = out++;
+    while((i < size) && (count < REWIND_MAX_RUN))
+    {
+      uInt8 value = sourceByte(data, reference, i);
+      if((value == 0) && ((i + 1 == size) ||
+                          (sourceByte(data, reference, i + 1) == 0)))
+        break;
+
+      *out++ = value;
+      ++i;
+      ++count;
+    }
+    *control = count - 1;
+  }
+
+  return out - myScratch;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::decode(const Record& record)
+{
+  const uInt8* in = myData + record.offset;
+  const uInt8* end = in + record.length;
+  uInt8* out = myState;
+
+  while(in < end)
+  {
+    uInt8 control = *in++;
+    uInt32 count = (control & ~REWIND_ZERO_RUN) + 1;
+
+    if(control & REWIND_ZERO_RUN)
+    {
+      // Nothing changed, unless the state is replaced
+      if(record.keyframe)
+        memset(out, 0, count);
+    }
+    else
+    {
+      if(record.keyframe)
+        memcpy(out, in, count);
+      else
+        for(uInt32 i = 0; i < count; ++i)
+          out[i] ^= in[i];
+
+      in += count;
+    }
+    out += count;
+  }
+
+  myStateSize = record.stateSize;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindBuffer::allocate(uInt32 length, uInt32& offset)
+{
+  if(length > myDataSize)
+    return false;
+
+  for(;;)
+  {
+    if(myCount == 0)
+    {
+      offset = 0;
+      return true;
+    }
+
+    if(myCount < myMaxRecords)
+    {
+      const Record& oldest = record(0);
+      const Record& newest = record(myCount - 1);
+      uInt32 head = newest.offset + newest.length;
+
+      if(newest.offset >= oldest.offset)
+      {
+        // The records are in one piece, there's room after and before them
+        if(head + length <= myDataSize)
+        {
+          offset = head;
+          return true;
+        }
+        else if(length <= oldest.offset)
+        {
+          offset = 0;
+          return true;
+        }
+      }
+      else if(head + length <= oldest.offset)
+      {
+        // The records wrapped around, there's only room in between
+        offset = head;
+        return true;
+      }
+    }
+
+    dropOldest();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::dropOldest()
+{
+  // Differences can't be decoded once the keyframe before them is gone
+  do
+  {
+    myFirst = (myFirst + 1) % myMaxRecords;
+    --myCount;
+  }
+  while((myCount > 0) && !record(0).keyframe);
+}
@@ -0,0 +1,148 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef REWIND_BUFFER_HXX
+#define REWIND_BUFFER_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class keeps the most recent machine states (as written by a
+  Serializer) in a fixed amount of memory, so that the emulation can
+  be stepped back in time.
+
+  Most states are stored as the difference with the state before them:
+  the two are XOR'ed, which leaves mostly zeros, and the result is run
+  length encoded.  Every few states a full (but also run length encoded)
+  keyframe is stored instead, so that the oldest states can be dropped
+  when space runs out.
+
+  The newest state is always kept decoded.  Stepping back applies its
+  difference once more, which gives the state before it.
+*/
+class RewindBuffer
+{
+  public:
+    /**
+      Creates a new rewind buffer
+
+      @param states    The maximum number of states kept
+      @param size      The number of bytes used to store them
+      @param keyframe  The number of states from one keyframe to the next
+    */
+    RewindBuffer(uInt32 states, uInt32 size, uInt32 keyframe);
+
+    /**
+      Destructor
+    */
+    virtual ~RewindBuffer();
+
+  public:
+    /**
+      Adds a state after the newest one.  The oldest states are dropped
+      if there's no room left for it.
+
+      @param data  The serialized state
+      @param size  The size of the state in bytes
+    */
+    void push(const uInt8* data, uInt32 size);
+
+    /**
+      Drops the newest state, making the one before it the newest.
+
+      @return False if there is no earlier state (the newest one is kept)
+    */
+    bool pop();
+
+    /**
+      Drops all the states.
+    */
+    void clear();
+
+    /**
+      Answers the number of states kept
+    */
+    uInt32 states() const { return myCount; }
+
+    /**
+      Answers the newest state, which is only valid if states() > 0 and
+      until the next push() or pop().
+    */
+    const uInt8* data() const { return myState; }
+
+    /**
+      Answers the size in bytes of the newest state
+    */
+    uInt32 size() const { return myStateSize; }
+
+  private:
+    // A state stored in the buffer
+    struct Record
+    {
+      uInt32 offset;     // Where its encoded data starts in myData
+      uInt32 length;     // The size of its encoded data
+      uInt32 stateSize;  // The size of the state once decoded
+      bool keyframe;     // Whether it's complete or a difference
+    };
+
+    // Run length encodes the given bytes, XOR'ed with the reference bytes
+    // if there are any, into myScratch and answers the encoded size
+    uInt32 encode(const uInt8* data, const uInt8* reference, uInt32 size);
+
+    // Decodes a record into myState; a keyframe replaces the state and
+    // a difference is XOR'ed into it
+    void decode(const Record& record);
+
+    // Reserves room for the given number of bytes after the newest record,
+    // dropping the oldest records if needed, and answers its offset
+    bool allocate(uInt32 length, uInt32& offset);
+
+    // Drops the oldest record, along with the differences that need it
+    void dropOldest();
+
+    // Answers the record at the given position from the oldest one
+    Record& record(uInt32 i) { return myRecords[(myFirst + i) % myMaxRecords]; }
+
+  private:
+    // The records, used as a circular buffer
+    Record* myRecords;
+    uInt32 myMaxRecords;
+    uInt32 myFirst;
+    uInt32 myCount;
+
+    // The encoded states, in the same order as the records
+    uInt8* myData;
+    uInt32 myDataSize;
+
+    // Number of records from one keyframe to the next
+    uInt32 myKeyframeInterval;
+
+    // Number of records pushed since the last keyframe
+    uInt32 myRecordsSinceKeyframe;
+
+    // The newest state, decoded
+    uInt8* myState;
+    uInt32 myStateSize;
+    uInt32 myStateCapacity;
+
+    // Where states are encoded before being copied into myData
+    uInt8* myScratch;
+    uInt32 myScratchCapacity;
+};
+
+#endif
@@ -16,10 +16,16 @@
 // $Id: Serializer.cxx,v 1.9 2005/12/29 21:16:28 stephena Exp $
 //============================================================================
 
+#include <string.h>
+
 #include "Serializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(void)
+  : myData(0),
+    mySize(0),
+    myCapacity(0),
+    myMemoryFlag(false)
 {
 }
 
@@ -27,13 +33,24 @@ Serializer::Serializer(void)
 Serializer::~Serializer(void)
 {
   close();
+
+  delete[] myData;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Serializer::open(const string& fileName)
 {
   close();
-  myStream.open(fileName.c_str(), ios::out | ios::binary);
+  myFile.open(fileName.c_str(), ios::out | ios::binary);
+
+  return isOpen();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Serializer::openMemory(void)
+{
+  close();
+  myMemoryFlag = true;
 
   return isOpen();
 }
@@ -41,31 +58,62 @@ bool Serializer::open(const string& fileName)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::close(void)
 {
-  myStream.close();
-  myStream.clear();
+  if(myFile.is_open())
+  {
+    myFile.write((char*)myData, (streamsize)mySize);
+    if(myFile.bad()) {
+# if 0 //LUDO:
+      throw "Serializer: file write failed";
+# else
+      exit(1);
+# endif
+    }
+  }
+
+  myFile.close();
+  myFile.clear();
+
+  // The buffer is kept for the next time
+  mySize = 0;
+  myMemoryFlag = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Serializer::isOpen(void)
 {
-  return myStream.is_open();
+  return myMemoryFlag || myFile.is_open();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::reserve(uInt32 size)
+{
+  if(size <= myCapacity)
+    return;
+
+  uInt32 capacity = (myCapacity > 0) ? myCapacity : (uInt32)InitialCapacity;
+  while(capacity < size)
+    capacity <<= 1;
+
+  uInt8* data = new uInt8[capacity];
+  if(mySize > 0)
+    memcpy(data, myData, mySize);
+
+  delete[] myData;
+  myData = data;
+  myCapacity = capacity;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(int value)
 {
-  unsigned char buf[4];
+  if(mySize + 4 > myCapacity)
+    reserve(mySize + 4);
+
+  uInt8* buf = myData + mySize;
   for(int i = 0; i < 4; ++i)
     buf[i] = (value >> (i<<3)) & 0xff;
 
-  myStream.write((char*)buf, 4);
-  if(myStream.bad()) {
-# if 0 //LUDO:
-    throw "Serializer: file write failed";
-# else
-    exit(1);
-# endif
-  }
+  mySize += 4;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -73,15 +121,12 @@ void Serializer::putString(const string& str)
 {
   int len = str.length();
   putInt(len);
-  myStream.write(str.data(), (streamsize)len);
 
-  if(myStream.bad()) {
-# if 0 //LUDO:
-    throw "Serializer: file write failed";
-# else
-    exit(1);
-# endif
-  }
+  if(mySize + len > myCapacity)
+    reserve(mySize + len);
+
+  memcpy(myData + mySize, str.data(), len);
+  mySize += len;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -25,7 +25,9 @@
 /**
   This class implements a Serializer device, whereby data is
   serialized and sent to an output binary file in a system-
-  independent way.
+  independent way.  The data is gathered in a memory buffer, which
+  is written to the file in one go when it's closed; it can also
+  stay in memory, for snapshots that are restored right away.
 
   All bytes and integers are written as int's.  Strings are
   written as characters prepended by the length of the string.
@@ -53,7 +55,8 @@ class Serializer
   public:
     /**
       Opens the given file for output.  Multiple calls to this method
-      will close previously opened files.
+      will close previously opened files.  Nothing is written to the
+      file until it's closed.
 
       @param fileName The filename to send the serialized data to.
       @return Result of opening the file.  True on success, false on failure
@@ -61,7 +64,30 @@ class Serializer
     bool open(const string& fileName);
 
     /**
-      Closes the current output stream.
+      Opens an empty memory buffer for output.  Multiple calls to this
+      method will close previously opened files and discard the data
+      written so far, but keep the memory allocated for it.
+
+      @return Result of opening the buffer, always true
+    */
+    bool openMemory(void);
+
+    /**
+      Answers the data written since the serializer was opened.  The
+      pointer is only valid until the next call to a non-const method.
+
+      @return The serialized data, to be given to Deserializer::openMemory()
+    */
+    const uInt8* data(void) const { return myData; }
+
+    /**
+      Answers the number of bytes written since the serializer was opened.
+    */
+    uInt32 size(void) const { return mySize; }
+
+    /**
+      Closes the current output stream, writing the data to the file
+      if one was opened.
     */
     void close(void);
 
@@ -92,13 +118,28 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
-    fstream myStream;
+    // Make sure the buffer can hold the given number of bytes
+    void reserve(uInt32 size);
+
+  private:
+    // The file to send the serialized data to when closed
+    fstream myFile;
+
+    // The serialized data, and the number of bytes allocated for it
+    uInt8* myData;
+    uInt32 mySize;
+    uInt32 myCapacity;
+
+    // Indicates whether the data is only kept in memory
+    bool myMemoryFlag;
 
     enum {
       TruePattern  = 0xfab1fab2,
       FalsePattern = 0xbad1bad2
     };
+
+    // A complete machine state fits without growing the buffer
+    enum { InitialCapacity = 4096 };
 };
 
 #endif
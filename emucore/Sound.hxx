@@ -134,6 +134,15 @@ class Sound
     */
     virtual void adjustVolume(Int8 direction) = 0;
 
+    /**
+      Answers how much sound, in seconds, has been emulated but not yet
+      handed to the sound device.  Frames can be paced on this to stay
+      in step with the device's clock.
+
+      @return The buffered duration, or a negative value if it's unknown
+    */
+    virtual double bufferedDuration() = 0;
+
 public:
     /**
       Loads the current state of this device from the given Deserializer.
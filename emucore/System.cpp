@@ -32,6 +32,8 @@ System::System(uInt16 n, uInt16 m)
     myPageShift(m),
     myPageMask((1 << m) - 1),
     myNumberOfPages(1 << (n - m)),
+    myPageAccessGeneration(0),
+    myNumberOfPageAccessObservers(0),
     myNumberOfDevices(0),
     myM6502(0),
     myTIA(0),
@@ -45,10 +47,7 @@ System::System(uInt16 n, uInt16 m)
   myPageAccessTable = new PageAccess[myNumberOfPages];
 
   // Initialize page access table
-  PageAccess access;
-  access.directPeekBase = 0;
-  access.directPokeBase = 0;
-  access.device = &myNullDevice;
+  PageAccess access(&myNullDevice);
   for(int page = 0; page < myNumberOfPages; ++page)
   {
     setPageAccess(page, access);
@@ -195,6 +194,19 @@ void System::setPageAccess(uInt16 page, const PageAccess& access)
   assert(access.device != 0);
 
   myPageAccessTable[page] = access;
+
+  // Pages without handlers of their own go through the virtual methods
+  if(access.peekHandler == 0)
+    myPageAccessTable[page].peekHandler = &System::peekVirtual;
+  if(access.pokeHandler == 0)
+    myPageAccessTable[page].pokeHandler = &System::pokeVirtual;
+
+  // Let everyone who cached something about this page know it's changed
+  ++myPageAccessGeneration;
+  for(uInt32 i = 0; i < myNumberOfPageAccessObservers; ++i)
+  {
+    myPageAccessObservers[i]->pageAccessChanged(page);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -206,6 +218,40 @@ const System::PageAccess& System::getPageAccess(uInt16 page)
   return myPageAccessTable[page];
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 System::peekVirtual(Device* device, uInt16 address)
+{
+  return device->peek(address);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::pokeVirtual(Device* device, uInt16 address, uInt8 value)
+{
+  device->poke(address, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::addPageAccessObserver(PageAccessObserver* observer)
+{
+  assert(myNumberOfPageAccessObservers < 10);
+
+  myPageAccessObservers[myNumberOfPageAccessObservers++] = observer;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::removePageAccessObserver(PageAccessObserver* observer)
+{
+  for(uInt32 i = 0; i < myNumberOfPageAccessObservers; ++i)
+  {
+    if(myPageAccessObservers[i] == observer)
+    {
+      myPageAccessObservers[i] =
+          myPageAccessObservers[--myNumberOfPageAccessObservers];
+      break;
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool System::saveState(const string& md5sum, Serializer& out)
 {
@@ -310,20 +356,9 @@ System& System::operator = (const System&)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-static System::PageAccess* last_access = 0;
-static uInt16      last_addr = 0xffff;
-
 uInt8 System::peek(uInt16 addr)
 {
-  PageAccess* access;
-  uInt16 t = addr & myAddressMask;
-  if (t == last_addr) {
-    access = last_access;
-  } else {
-    last_addr = t;
-    access = &myPageAccessTable[last_addr >> myPageShift];
-    last_access = access;
-  }
+  PageAccess* access = &myPageAccessTable[(addr & myAddressMask) >> myPageShift];
 
   uInt8 result;
  
@@ -334,7 +369,7 @@ uInt8 System::peek(uInt16 addr)
   }
   else
   {
-    result = access->device->peek(addr);
+    result = access->peekHandler(access->device, addr);
   }
 
 #ifdef DEVELOPER_SUPPORT
@@ -348,15 +383,7 @@ uInt8 System::peek(uInt16 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void System::poke(uInt16 addr, uInt8 value)
 {
-  PageAccess* access;
-  uInt16 t = addr & myAddressMask;
-  if (t == last_addr) {
-    access = last_access;
-  } else {
-    last_addr = t;
-    access = &myPageAccessTable[last_addr >> myPageShift];
-    last_access = access;
-  }
+  PageAccess* access = &myPageAccessTable[(addr & myAddressMask) >> myPageShift];
   
   // See if this page uses direct accessing or not 
   if(access->directPokeBase != 0)
@@ -365,7 +392,7 @@ void System::poke(uInt16 addr, uInt8 value)
   }
   else
   {
-    access->device->poke(addr, value);
+    access->pokeHandler(access->device, addr, value);
   }
 
 #ifdef DEVELOPER_SUPPORT
@@ -401,7 +428,20 @@ bool System::cheat_poke(uInt16 addr, uInt8 value)
   // See if this page uses direct accessing or not 
   if(access->directPeekBase != 0)
   {
-    *(access->directPeekBase + (addr & myPageMask)) = value;
+    uInt8* byte = access->directPeekBase + (addr & myPageMask);
+
+    // Cheats are applied every frame, but observers only need to hear
+    // about the ones which change something
+    if(*byte != value)
+    {
+      *byte = value;
+
+      ++myPageAccessGeneration;
+      for(uInt32 i = 0; i < myNumberOfPageAccessObservers; ++i)
+      {
+        myPageAccessObservers[i]->memoryChanged(addr);
+      }
+    }
     return true;
   }
   return false;
@@ -40,11 +40,10 @@ class Deserializer;
   In general the addressing space will be 8192 (2^13) bytes for a 
   6507 based system and 65536 (2^16) bytes for a 6502 based system.
 
-  TODO: To allow for dynamic code generation we probably need to
-        add a tag to each page that indicates if it is read only
-        memory.  We also need to notify the processor anytime a
-        page access method is changed so that it can clear the
-        dynamic code for that page of memory.
+  Anything which caches what it learned from the page access table
+  (i.e. a processor keeping decoded instructions around) can register
+  itself as a page access observer, or compare the page access
+  generation, to find out when a page has been remapped.
 
   @author  Bradford W. Mott
   @version $Id: System.hxx,v 1.14 2006/02/10 13:14:20 stephena Exp $
@@ -239,6 +238,15 @@ class System
     */  
     uInt8 getDataBusState() const;
 
+    /**
+      Set the current state of the data bus, as if the given byte had
+      just been read.  Used by processors which fetch instructions
+      without going through peek().
+
+      @param value The byte last seen on the data bus
+    */
+    void setDataBusState(uInt8 value);
+
     /**
       Get the byte at the specified address.  No masking of the
       address occurs before it's sent to the device mapped at
@@ -274,11 +282,103 @@ class System
     void unlockDataBus();
 
   public:
+    /**
+      Interface for objects which want to know when the access methods
+      of a page change, or when memory is modified behind the system's
+      back.
+    */
+    class PageAccessObserver
+    {
+      public:
+        /**
+          Destructor
+        */
+        virtual ~PageAccessObserver() { }
+
+        /**
+          Invoked after the access methods of the specified page have
+          been changed (i.e. a cartridge switched banks).
+
+          @param page The page whose access methods have changed
+        */
+        virtual void pageAccessChanged(uInt16 page) = 0;
+
+        /**
+          Invoked after the byte at the specified address has been
+          changed without going through poke() (i.e. by a cheat).
+
+          @param address The address of the byte which has changed
+        */
+        virtual void memoryChanged(uInt16 address) = 0;
+    };
+
+    /**
+      Functions used to read and write a device mapped into a page.  They
+      are plain function pointers, so the device's methods are reached
+      without going through its virtual table.
+    */
+    typedef uInt8 (*PeekHandler)(Device* device, uInt16 address);
+    typedef void (*PokeHandler)(Device* device, uInt16 address, uInt8 value);
+
+    /**
+      Handlers calling the peek and poke methods of the device class T
+      directly.  They should be instantiated where T's methods are
+      defined so the compiler can inline them.
+    */
+    template<class T>
+    static uInt8 peekDevice(Device* device, uInt16 address)
+    {
+      return static_cast<T*>(device)->T::peek(address);
+    }
+
+    template<class T>
+    static void pokeDevice(Device* device, uInt16 address, uInt8 value)
+    {
+      static_cast<T*>(device)->T::poke(address, value);
+    }
+
+    /**
+      Handlers going through the virtual peek and poke methods, used for
+      pages set up without handlers of their own
+    */
+    static uInt8 peekVirtual(Device* device, uInt16 address);
+    static void pokeVirtual(Device* device, uInt16 address, uInt8 value);
+
     /**
       Structure used to specify access methods for a page
     */
     struct PageAccess
     {
+      /**
+        Create access methods for a page which isn't mapped to a device
+        yet.  The fields have to be filled in before it's installed.
+      */
+      PageAccess()
+        : directPeekBase(0),
+          directPokeBase(0),
+          device(0),
+          peekHandler(0),
+          pokeHandler(0)
+      {
+      }
+
+      /**
+        Create access methods for a page mapped to the given device, with
+        handlers calling the device class directly.  Devices use this in
+        install() and when switching banks.
+
+        @param owner The device the page is mapped to
+      */
+      template<class T>
+      explicit PageAccess(T* owner)
+        : directPeekBase(0),
+          directPokeBase(0),
+          device(owner),
+          peekHandler(&peekDevice<T>),
+          pokeHandler(&pokeDevice<T>)
+      {
+      }
+
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
         indicates that the device's peek method should be invoked for reads
@@ -300,6 +400,14 @@ class System
         null device if the page hasn't been mapped to a device
       */
       Device* device;
+
+      /**
+        Functions invoked for reads and writes to this page which don't
+        use direct accessing.  The null pointer means the device's
+        virtual methods are used.
+      */
+      PeekHandler peekHandler;
+      PokeHandler pokeHandler;
     };
 
     /**
@@ -317,6 +425,34 @@ class System
       @return The accessing methods used by the page
     */
     const PageAccess& getPageAccess(uInt16 page);
+
+    /**
+      Register an observer to be told about page access changes.  The
+      system doesn't take ownership of the observer.
+
+      @param observer The observer to add
+    */
+    void addPageAccessObserver(PageAccessObserver* observer);
+
+    /**
+      Stop telling the specified observer about page access changes.
+
+      @param observer The observer to remove
+    */
+    void removePageAccessObserver(PageAccessObserver* observer);
+
+    /**
+      Get a counter which changes every time a page access method is
+      changed or memory is modified behind the system's back.  Anything
+      computed from the page access table is still valid as long as the
+      counter hasn't changed.
+
+      @return The page access generation
+    */
+    uInt32 pageAccessGeneration() const
+    {
+      return myPageAccessGeneration;
+    }
  
   private:
     // Mask to apply to an address before accessing memory
@@ -334,6 +470,15 @@ class System
     // Pointer to a dynamically allocated array of PageAccess structures
     PageAccess* myPageAccessTable;
 
+    // Incremented every time the page access table changes
+    uInt32 myPageAccessGeneration;
+
+    // Objects to tell about page access changes
+    PageAccessObserver* myPageAccessObservers[10];
+
+    // Number of page access observers
+    uInt32 myNumberOfPageAccessObservers;
+
     // Array of all the devices attached to the system
     Device* myDevices[100];
 
@@ -374,4 +519,13 @@ inline uInt8 System::getDataBusState() const
   return myDataBusState;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void System::setDataBusState(uInt8 value)
+{
+#ifdef DEVELOPER_SUPPORT
+  if(!myDataBusLocked)
+#endif
+    myDataBusState = value;
+}
+
 #endif
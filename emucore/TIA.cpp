@@ -39,6 +39,7 @@ TIA::TIA(const Console& console, Settings& settings)
     : myConsole(console),
       mySettings(settings),
       mySound(NULL),
+      myScanlineListener(NULL),
       myColorLossEnabled(false),
       myMaximumNumberOfScanlines(262),
       myCOLUBK(myColor[0]),
@@ -53,59 +54,23 @@ TIA::TIA(const Console& console, Settings& settings)
   myPreviousFrameBuffer = new uInt8[160 * 300];
 
   myFrameGreyed = false;
+  myPartialFrameFlag = false;
+  mySpeculativeFlag = false;
+  myRenderingFlag = true;
 
   for(i = 0; i < 6; ++i)
     myBitEnabled[i] = true;
 
-  for(uInt16 x = 0; x < 2; ++x)
+  // Written a byte at a time, so that the first pixel is the byte at
+  // the lowest address whatever the byte order
+  for(i = 0; i < 16; ++i)
   {
-    for(uInt16 enabled = 0; enabled < 256; ++enabled)
-    {
-      if(enabled & PriorityBit)
-      {
-        uInt8 color = 0;
-
-        if((enabled & (myP1Bit | myM1Bit)) != 0)
-          color = 3;
-        if((enabled & (myP0Bit | myM0Bit)) != 0)
-          color = 2;
-        if((enabled & myBLBit) != 0)
-          color = 1;
-        if((enabled & myPFBit) != 0)
-          color = 1;  // NOTE: Playfield has priority so ScoreBit isn't used
+    uInt8* bytes = (uInt8*)&myPixelMasks[i];
 
-        myPriorityEncoder[x][enabled] = color;
-      }
-      else
-      {
-        uInt8 color = 0;
-
-        if((enabled & myBLBit) != 0)
-          color = 1;
-        if((enabled & myPFBit) != 0)
-          color = (enabled & ScoreBit) ? ((x == 0) ? 2 : 3) : 1;
-        if((enabled & (myP1Bit | myM1Bit)) != 0)
-          color = 3;
-        if((enabled & (myP0Bit | myM0Bit)) != 0)
-          color = 2;
-
-        myPriorityEncoder[x][enabled] = color;
-      }
-    }
+    for(uInt32 b = 0; b < 4; ++b)
+      bytes[b] = (i & (1 << b)) ? 0xFF : 0x00;
   }
 
-  for(i = 0; i < 640; ++i)
-    ourDisabledMaskTable[i] = 0;
-
-  // Compute all of the mask tables
-  computeBallMaskTable();
-  computeCollisionTable();
-  computeMissleMaskTable();
-  computePlayerMaskTable();
-  computePlayerPositionResetWhenTable();
-  computePlayerReflectTable();
-  computePlayfieldMaskTable();
-
   // Init stats counters
   myFrameCounter = 0;
 
@@ -190,6 +155,10 @@ void TIA::reset()
   myRESMP0 = false;
   myRESMP1 = false;
   myCollision = 0;
+  myCollisionSpanCount = 0;
+  myCollisionSpanEnd = NULL;
+  myLazyCollisionsFlag = false;
+  myCollisionsReadFlag = false;
   myPOSP0 = 0;
   myPOSP1 = 0;
   myPOSM0 = 0;
@@ -199,13 +168,16 @@ void TIA::reset()
   // Some default values for the "current" variables
   myCurrentGRP0 = 0;
   myCurrentGRP1 = 0;
-  myCurrentBLMask = ourBallMaskTable[0][0];
-  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
+  myCurrentBLMask = 0;
+  myCurrentM0Mask = 0;
+  myCurrentM1Mask = 0;
+  myCurrentP0Mask = 0;
+  myCurrentP1Mask = 0;
   myCurrentPFMask = ourPlayfieldTable[0];
 
+  // No playfield register and reflection state gives this key
+  myPlayfieldBitsKey = 0xFFFFFFFF;
+
   myLastHMOVEClock = 0;
   myHMOVEBlankEnabled = false;
   myM0CosmicArkMotionEnabled = false;
@@ -258,7 +230,8 @@ void TIA::systemCyclesReset()
   uInt32 cycles = mySystem->cycles();
 
   // Adjust the sound cycle indicator
-  mySound->adjustCycleCounter(-1 * cycles);
+  if(!mySpeculativeFlag)
+    mySound->adjustCycleCounter(-1 * cycles);
 
   // Adjust the dump cycle
   myDumpDisabledCycle -= cycles;
@@ -285,10 +258,9 @@ void TIA::install(System& system)
   mySystem->resetCycles();
 
   // All accesses are to this device
-  System::PageAccess access;
+  System::PageAccess access(this);
   access.directPeekBase = 0;
   access.directPokeBase = 0;
-  access.device = this;
 
   // We're installing in a 2600 system
   for(uInt32 i = 0; i < 8192; i += (1 << shift))
@@ -308,7 +280,8 @@ bool TIA::save(Serializer& out)
 
   try
   {
-    out.putString(device);
+    // The version tag tells old states, which end with the sound, apart
+    out.putString(device + string(" v2"));
 
     out.putInt(myClockWhenFrameStarted);
     out.putInt(myClockStartDisplay);
@@ -354,6 +327,7 @@ bool TIA::save(Serializer& out)
     out.putBool(myVDELBL);
     out.putBool(myRESMP0);
     out.putBool(myRESMP1);
+    updateCollisions();
     out.putInt(myCollision);
     out.putInt(myPOSP0);
     out.putInt(myPOSP1);
@@ -364,13 +338,13 @@ bool TIA::save(Serializer& out)
     out.putInt(myCurrentGRP0);
     out.putInt(myCurrentGRP1);
 
-// pointers
-//  myCurrentBLMask = ourBallMaskTable[0][0];
-//  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentPFMask = ourPlayfieldTable[0];
+    // Masks are saved as bits of their packed tables
+    out.putInt(myCurrentBLMask);
+    out.putInt(myCurrentM0Mask);
+    out.putInt(myCurrentM1Mask);
+    out.putInt(myCurrentP0Mask);
+    out.putInt(myCurrentP1Mask);
+    out.putInt(myCurrentPFMask - &ourPlayfieldTable[0][0]);
 
     out.putInt(myLastHMOVEClock);
     out.putBool(myHMOVEBlankEnabled);
@@ -380,8 +354,21 @@ bool TIA::save(Serializer& out)
     out.putBool(myDumpEnabled);
     out.putInt(myDumpDisabledCycle);
 
+    out.putInt(myAUDV0);
+    out.putInt(myAUDV1);
+    out.putInt(myAUDC0);
+    out.putInt(myAUDC1);
+    out.putInt(myAUDF0);
+    out.putInt(myAUDF1);
+
+    out.putBool(myPartialFrameFlag);
+    out.putBool(myFrameGreyed);
+    out.putInt(myFrameCounter);
+    out.putInt(myFramePointer - myCurrentFrameBuffer);
+
     // Save the sound sample stuff ...
-    mySound->save(out);
+    if(!mySpeculativeFlag)
+      mySound->save(out);
   }
 # if 0 //LUDO:
   catch(char *msg)
@@ -406,7 +393,9 @@ bool TIA::load(Deserializer& in)
 
   try
   {
-    if(in.getString() != device)
+    string version = in.getString();
+    bool extended = (version == device + string(" v2"));
+    if(!extended && (version != device))
       return false;
 
     myClockWhenFrameStarted = (Int32) in.getInt();
@@ -454,6 +443,7 @@ bool TIA::load(Deserializer& in)
     myRESMP0 = in.getBool();
     myRESMP1 = in.getBool();
     myCollision = (uInt16) in.getInt();
+    myCollisionSpanCount = 0;
     myPOSP0 = (Int16) in.getInt();
     myPOSP1 = (Int16) in.getInt();
     myPOSM0 = (Int16) in.getInt();
@@ -463,13 +453,28 @@ bool TIA::load(Deserializer& in)
     myCurrentGRP0 = (uInt8) in.getInt();
     myCurrentGRP1 = (uInt8) in.getInt();
 
-// pointers
-//  myCurrentBLMask = ourBallMaskTable[0][0];
-//  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentPFMask = ourPlayfieldTable[0];
+    // Older states don't have these, the current masks are kept then
+    if(extended)
+    {
+      myCurrentBLMask = (uInt32) in.getInt();
+      myCurrentM0Mask = (uInt32) in.getInt();
+      myCurrentM1Mask = (uInt32) in.getInt();
+      myCurrentP0Mask = (uInt32) in.getInt();
+      myCurrentP1Mask = (uInt32) in.getInt();
+      if(!validMask(myCurrentBLMask, 4) || !validMask(myCurrentM0Mask, 9 * 4) ||
+         !validMask(myCurrentM1Mask, 9 * 4) ||
+         !validMask(myCurrentP0Mask, 2 * 8 * 9) ||
+         !validMask(myCurrentP1Mask, 2 * 8 * 9))
+      {
+        return false;
+      }
+
+      // The playfield mask is one of the rows of its table
+      Int32 playfield = (Int32) in.getInt();
+      if((playfield < 0) || (playfield >= 2 * 160) || (playfield % 160 != 0))
+        return false;
+      myCurrentPFMask = &ourPlayfieldTable[0][0] + playfield;
+    }
 
     myLastHMOVEClock = (Int32) in.getInt();
     myHMOVEBlankEnabled = in.getBool();
@@ -479,11 +484,33 @@ bool TIA::load(Deserializer& in)
     myDumpEnabled = in.getBool();
     myDumpDisabledCycle = (Int32) in.getInt();
 
+    if(extended)
+    {
+      myAUDV0 = (uInt8) in.getInt();
+      myAUDV1 = (uInt8) in.getInt();
+      myAUDC0 = (uInt8) in.getInt();
+      myAUDC1 = (uInt8) in.getInt();
+      myAUDF0 = (uInt8) in.getInt();
+      myAUDF1 = (uInt8) in.getInt();
+
+      myPartialFrameFlag = in.getBool();
+      myFrameGreyed = in.getBool();
+      myFrameCounter = in.getInt();
+
+      Int32 frame = (Int32) in.getInt();
+      if((frame < 0) || (frame > 160 * 300))
+        return false;
+      myFramePointer = myCurrentFrameBuffer + frame;
+    }
+
     // Load the sound sample stuff ...
-    mySound->load(in);
+    if(!mySpeculativeFlag)
+    {
+      mySound->load(in);
 
-    // Reset TIA bits to be on
-    enableBits(true);
+      // Reset TIA bits to be on
+      enableBits(true);
+    }
   }
 # if 0 //LUDO:
   catch(char *msg)
@@ -523,7 +550,7 @@ void TIA::update()
 
   if(myPartialFrameFlag) {
     // grey out old frame contents
-    if(!myFrameGreyed) greyOutFrame();
+    if(!myFrameGreyed && myRenderingFlag) greyOutFrame();
     myFrameGreyed = true;
   } else {
     endFrame();
@@ -534,9 +561,13 @@ void TIA::update()
 inline void TIA::startFrame()
 {
   // This stuff should only happen at the beginning of a new frame.
-  uInt8* tmp = myCurrentFrameBuffer;
-  myCurrentFrameBuffer = myPreviousFrameBuffer;
-  myPreviousFrameBuffer = tmp;
+  // A frame which isn't drawn leaves the frame buffers as they were.
+  if(myRenderingFlag)
+  {
+    uInt8* tmp = myCurrentFrameBuffer;
+    myCurrentFrameBuffer = myPreviousFrameBuffer;
+    myPreviousFrameBuffer = tmp;
+  }
 
   // Remember the number of clocks which have passed on the current scanline
   // so that we can adjust the frame's starting clock by this amount.  This
@@ -557,6 +588,12 @@ inline void TIA::startFrame()
   // Reset frame buffer pointer
   myFramePointer = myCurrentFrameBuffer;
 
+  // Keep the collisions for when they're read, unless the game did read
+  // them during the last frame
+  myLazyCollisionsFlag = !myCollisionsReadFlag;
+  myCollisionsReadFlag = false;
+  myCollisionSpanEnd = NULL;
+
   // If color loss is enabled then update the color registers based on
   // the number of scanlines in the last frame that was generated
   if(myColorLossEnabled)
@@ -590,9 +627,21 @@ inline void TIA::endFrame()
   // Stats counters
   myFrameCounter++;
 
+  if(myScanlineListener && myRenderingFlag)
+    myScanlineListener->frameDrawn(
+        (myFramePointer - myCurrentFrameBuffer) / myFrameWidth);
+
   myFrameGreyed = false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIA::validMask(uInt32 mask, uInt32 rows)
+{
+  // The first pixel of the scanline is never further than 160 bits into
+  // a row, so that 32 bits can be read from any pixel of the scanline
+  return (mask < rows * myMaskRowBits) && ((mask % myMaskRowBits) <= 160);
+}
+
 #ifdef DEVELOPER_SUPPORT
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateScanline()
@@ -603,7 +652,7 @@ void TIA::updateScanline()
   }
 
   // grey out old frame contents
-  if(!myFrameGreyed) greyOutFrame();
+  if(!myFrameGreyed && myRenderingFlag) greyOutFrame();
   myFrameGreyed = true;
 
   // true either way:
@@ -636,7 +685,7 @@ void TIA::updateScanlineByStep()
   }
 
   // grey out old frame contents
-  if(!myFrameGreyed) greyOutFrame();
+  if(!myFrameGreyed && myRenderingFlag) greyOutFrame();
   myFrameGreyed = true;
 
   // true either way:
@@ -665,7 +714,7 @@ void TIA::updateScanlineByTrace(int target)
   }
 
   // grey out old frame contents
-  if(!myFrameGreyed) greyOutFrame();
+  if(!myFrameGreyed && myRenderingFlag) greyOutFrame();
   myFrameGreyed = true;
 
   // true either way:
@@ -725,6 +774,12 @@ uInt32 TIA::scanlines() const
   return totalClocks/228;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIA::partialFrame() const
+{
+  return myPartialFrameFlag;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 TIA::clocksThisLine() const
 {
@@ -740,487 +795,234 @@ void TIA::setSound(Sound& sound)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeBallMaskTable()
+inline uInt32 TIA::maskBits(const uInt32* table, uInt32 bit)
 {
-  // First, calculate masks for alignment 0
-  for(Int32 size = 0; size < 4; ++size)
-  {
-    Int32 x;
-
-    // Set all of the masks to false to start with
-    for(x = 0; x < 160; ++x)
-    {
-      ourBallMaskTable[0][size][x] = false;
-    }
-
-    // Set the necessary fields true
-    for(x = 0; x < 160 + 8; ++x)
-    {
-      if((x >= 0) && (x < (1 << size)))
-      {
-        ourBallMaskTable[0][size][x % 160] = true;
-      }
-    }
+  const uInt32* word = table + (bit >> 5);
+  uInt32 shift = bit & 0x1F;
 
-    // Copy fields into the wrap-around area of the mask
-    for(x = 0; x < 160; ++x)
-    {
-      ourBallMaskTable[0][size][x + 160] = ourBallMaskTable[0][size][x];
-    }
-  }
-
-  // Now, copy data for alignments of 1, 2 and 3
-  for(uInt32 align = 1; align < 4; ++align)
-  {
-    for(uInt32 size = 0; size < 4; ++size)
-    {
-      for(uInt32 x = 0; x < 320; ++x)
-      {
-        ourBallMaskTable[align][size][x] = 
-            ourBallMaskTable[0][size][(x + 320 - align) % 320];
-      }
-    }
-  }
+  return shift ? ((word[0] >> shift) | (word[1] << (32 - shift))) : word[0];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeCollisionTable()
+inline uInt32 TIA::ballBits(uInt32 bit) const
 {
-  for(uInt8 i = 0; i < 64; ++i)
-  { 
-    ourCollisionTable[i] = 0;
-
-    if((i & myM0Bit) && (i & myP1Bit))    // M0-P1
-      ourCollisionTable[i] |= 0x0001;
-
-    if((i & myM0Bit) && (i & myP0Bit))    // M0-P0
-      ourCollisionTable[i] |= 0x0002;
-
-    if((i & myM1Bit) && (i & myP0Bit))    // M1-P0
-      ourCollisionTable[i] |= 0x0004;
-
-    if((i & myM1Bit) && (i & myP1Bit))    // M1-P1
-      ourCollisionTable[i] |= 0x0008;
-
-    if((i & myP0Bit) && (i & myPFBit))    // P0-PF
-      ourCollisionTable[i] |= 0x0010;
-
-    if((i & myP0Bit) && (i & myBLBit))    // P0-BL
-      ourCollisionTable[i] |= 0x0020;
-
-    if((i & myP1Bit) && (i & myPFBit))    // P1-PF
-      ourCollisionTable[i] |= 0x0040;
-
-    if((i & myP1Bit) && (i & myBLBit))    // P1-BL
-      ourCollisionTable[i] |= 0x0080;
-
-    if((i & myM0Bit) && (i & myPFBit))    // M0-PF
-      ourCollisionTable[i] |= 0x0100;
-
-    if((i & myM0Bit) && (i & myBLBit))    // M0-BL
-      ourCollisionTable[i] |= 0x0200;
-
-    if((i & myM1Bit) && (i & myPFBit))    // M1-PF
-      ourCollisionTable[i] |= 0x0400;
+  return maskBits(ourBallMaskTable[0], bit);
+}
 
-    if((i & myM1Bit) && (i & myBLBit))    // M1-BL
-      ourCollisionTable[i] |= 0x0800;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 TIA::missleBits(uInt32 bit)
+{
+  return maskBits(ourMissleMaskTable[0][0], bit);
+}
 
-    if((i & myBLBit) && (i & myPFBit))    // BL-PF
-      ourCollisionTable[i] |= 0x1000;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 TIA::playerBits(uInt32 bit, uInt8 graphics)
+{
+  const uInt32* table = ourPlayerMaskTable[0][0][0];
 
-    if((i & myP0Bit) && (i & myP1Bit))    // P0-P1
-      ourCollisionTable[i] |= 0x2000;
+  // Nothing to do where the player isn't shown at all
+  if((graphics == 0) || (maskBits(table, bit) == 0))
+    return 0;
 
-    if((i & myM0Bit) && (i & myM1Bit))    // M0-M1
-      ourCollisionTable[i] |= 0x4000;
+  // Each graphics bit has its own row, with the pixels showing that bit
+  uInt32 bits = 0;
+  for(bit += myMaskRowBits; graphics != 0; graphics >>= 1, bit += myMaskRowBits)
+  {
+    if(graphics & 0x01)
+      bits |= maskBits(table, bit);
   }
+  return bits;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeMissleMaskTable()
+inline uInt32 TIA::playfieldKey() const
 {
-  // First, calculate masks for alignment 0
-  Int32 x, size, number;
+  bool reflect = (myCurrentPFMask != ourPlayfieldTable[0]);
 
-  // Clear the missle table to start with
-  for(number = 0; number < 8; ++number)
-    for(size = 0; size < 4; ++size)
-      for(x = 0; x < 160; ++x)
-        ourMissleMaskTable[0][number][size][x] = false;
+  return myPF | (reflect ? 0x100000 : 0);
+}
 
-  for(number = 0; number < 8; ++number)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 TIA::playfieldBits(uInt32 key, uInt32 hpos)
+{
+  if(key != myPlayfieldBitsKey)
   {
-    for(size = 0; size < 4; ++size)
-    {
-      for(x = 0; x < 160 + 72; ++x)
-      {
-        // Only one copy of the missle
-        if((number == 0x00) || (number == 0x05) || (number == 0x07))
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-        // Two copies - close
-        else if(number == 0x01)
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-        // Two copies - medium
-        else if(number == 0x02)
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-        // Three copies - close
-        else if(number == 0x03)
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-        // Two copies - wide
-        else if(number == 0x04)
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-        // Three copies - medium
-        else if(number == 0x06)
-        {
-          if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-          else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
-        }
-      }
+    // The playfield bits in the order they're shown, from left to right,
+    // on each half of the scanline
+    uInt32 left = (key & 0xFF00F) |
+        ((uInt32)ourPlayerReflectTable[(key >> 4) & 0xFF] << 4);
+    uInt32 right = left;
 
-      // Copy data into wrap-around area
-      for(x = 0; x < 160; ++x)
-        ourMissleMaskTable[0][number][size][x + 160] = 
-          ourMissleMaskTable[0][number][size][x];
-    }
-  }
-
-  // Now, copy data for alignments of 1, 2 and 3
-  for(uInt32 align = 1; align < 4; ++align)
-  {
-    for(number = 0; number < 8; ++number)
+    if(key & 0x100000)
     {
-      for(size = 0; size < 4; ++size)
-      {
-        for(x = 0; x < 320; ++x)
-        {
-          ourMissleMaskTable[align][number][size][x] = 
-            ourMissleMaskTable[0][number][size][(x + 320 - align) % 320];
-        }
-      }
+      right = ((uInt32)ourPlayerReflectTable[left & 0xFF] << 12) |
+              ((uInt32)ourPlayerReflectTable[(left >> 8) & 0xFF] << 4) |
+              ((uInt32)ourPlayerReflectTable[(left >> 16) & 0x0F] >> 4);
     }
+
+    myPlayfieldBits[0] = ourPlayfieldExpandTable[left & 0xFF];
+    myPlayfieldBits[1] = ourPlayfieldExpandTable[(left >> 8) & 0xFF];
+    myPlayfieldBits[2] =
+        ourPlayfieldExpandTable[((left >> 16) & 0x0F) | ((right & 0x0F) << 4)];
+    myPlayfieldBits[3] = ourPlayfieldExpandTable[(right >> 4) & 0xFF];
+    myPlayfieldBits[4] = ourPlayfieldExpandTable[(right >> 12) & 0xFF];
+    myPlayfieldBits[5] = 0;
+
+    myPlayfieldBitsKey = key;
   }
+
+  return maskBits(myPlayfieldBits, hpos);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerMaskTable()
+inline void TIA::fillFrame(const uInt8* end, uInt32 color)
 {
-  // First, calculate masks for alignment 0
-  Int32 x, enable, mode;
-
-  // Set the player mask table to all zeros
-  for(enable = 0; enable < 2; ++enable)
-    for(mode = 0; mode < 8; ++mode)
-      for(x = 0; x < 160; ++x)
-        ourPlayerMaskTable[0][enable][mode][x] = 0x00;
-
-  // Now, compute the player mask table
-  for(enable = 0; enable < 2; ++enable)
+  // Update a uInt8 at a time until reaching a uInt32 boundary
+  for(; ((uintptr_t)myFramePointer & 0x03) && (myFramePointer < end);
+      ++myFramePointer)
   {
-    for(mode = 0; mode < 8; ++mode)
-    {
-      for(x = 0; x < 160 + 72; ++x)
-      {
-        if(mode == 0x00)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-        }
-        else if(mode == 0x01)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-          else if(((x - 16) >= 0) && ((x - 16) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 16);
-        }
-        else if(mode == 0x02)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-          else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
-        }
-        else if(mode == 0x03)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-          else if(((x - 16) >= 0) && ((x - 16) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 16);
-          else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
-        }
-        else if(mode == 0x04)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-          else if(((x - 64) >= 0) && ((x - 64) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 64);
-        }
-        else if(mode == 0x05)
-        {
-          // For some reason in double size mode the player's output
-          // is delayed by one pixel thus we use > instead of >=
-          if((enable == 0) && (x > 0) && (x <= 16))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/2);
-        }
-        else if(mode == 0x06)
-        {
-          if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
-          else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
-          else if(((x - 64) >= 0) && ((x - 64) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 64);
-        }
-        else if(mode == 0x07)
-        {
-          // For some reason in quad size mode the player's output
-          // is delayed by one pixel thus we use > instead of >=
-          if((enable == 0) && (x > 0) && (x <= 32))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/4);
-        }
-      }
-  
-      // Copy data into wrap-around area
-      for(x = 0; x < 160; ++x)
-      {
-        ourPlayerMaskTable[0][enable][mode][x + 160] = 
-            ourPlayerMaskTable[0][enable][mode][x];
-      }
-    }
+    *myFramePointer = color;
   }
 
-  // Now, copy data for alignments of 1, 2 and 3
-  for(uInt32 align = 1; align < 4; ++align)
+  // Now, update a uInt32 at a time, and the remaining uInt8s
+  for(; myFramePointer + 4 <= end; myFramePointer += 4)
   {
-    for(enable = 0; enable < 2; ++enable)
-    {
-      for(mode = 0; mode < 8; ++mode)
-      {
-        for(x = 0; x < 320; ++x)
-        {
-          ourPlayerMaskTable[align][enable][mode][x] =
-              ourPlayerMaskTable[0][enable][mode][(x + 320 - align) % 320];
-        }
-      }
-    }
+    *((uInt32*)myFramePointer) = color;
+  }
+  for(; myFramePointer < end; ++myFramePointer)
+  {
+    *myFramePointer = color;
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerPositionResetWhenTable()
+inline uInt32 TIA::pixelBits(uInt32 pixels)
 {
-  uInt32 mode, oldx, newx;
-
-  // Loop through all player modes, all old player positions, and all new
-  // player positions and determine where the new position is located:
-  // 1 means the new position is within the display of an old copy of the
-  // player, -1 means the new position is within the delay portion of an
-  // old copy of the player, and 0 means it's neither of these two
-  for(mode = 0; mode < 8; ++mode)
-  {
-    for(oldx = 0; oldx < 160; ++oldx)
-    {
-      // Set everything to 0 for non-delay/non-display section
-      for(newx = 0; newx < 160; ++newx)
-      {
-        ourPlayerPositionResetWhenTable[mode][oldx][newx] = 0;
-      }
+  return (pixels < 32) ? ((1 << pixels) - 1) : 0xFFFFFFFF;
+}
 
-      // Now, we'll set the entries for non-delay/non-display section
-      for(newx = 0; newx < 160 + 72 + 5; ++newx)
-      {
-        if(mode == 0x00)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt16 TIA::collisionBits(uInt32 p0, uInt32 m0, uInt32 p1, uInt32 m1,
+                                 uInt32 bl, uInt32 pf)
+{
+  uInt16 collision = 0;
+
+  if(m0 & p1)
+    collision |= ourCollisionTable[myM0Bit | myP1Bit];
+  if(m0 & p0)
+    collision |= ourCollisionTable[myM0Bit | myP0Bit];
+  if(m1 & p0)
+    collision |= ourCollisionTable[myM1Bit | myP0Bit];
+  if(m1 & p1)
+    collision |= ourCollisionTable[myM1Bit | myP1Bit];
+  if(p0 & pf)
+    collision |= ourCollisionTable[myP0Bit | myPFBit];
+  if(p0 & bl)
+    collision |= ourCollisionTable[myP0Bit | myBLBit];
+  if(p1 & pf)
+    collision |= ourCollisionTable[myP1Bit | myPFBit];
+  if(p1 & bl)
+    collision |= ourCollisionTable[myP1Bit | myBLBit];
+  if(m0 & pf)
+    collision |= ourCollisionTable[myM0Bit | myPFBit];
+  if(m0 & bl)
+    collision |= ourCollisionTable[myM0Bit | myBLBit];
+  if(m1 & pf)
+    collision |= ourCollisionTable[myM1Bit | myPFBit];
+  if(m1 & bl)
+    collision |= ourCollisionTable[myM1Bit | myBLBit];
+  if(bl & pf)
+    collision |= ourCollisionTable[myBLBit | myPFBit];
+  if(p0 & p1)
+    collision |= ourCollisionTable[myP0Bit | myP1Bit];
+  if(m0 & m1)
+    collision |= ourCollisionTable[myM0Bit | myM1Bit];
+
+  return collision;
+}
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x01)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x02)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x03)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x04)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x05)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void TIA::recordCollisions(uInt32 clocks, uInt32 hpos)
+{
+  uInt16 possible = ourCollisionTable[myEnabledObjects & 0x3F];
+  if((possible & ~myCollision) == 0)
+    return;
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 16)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x06)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x07)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+  uInt32 pfKey = playfieldKey();
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 32)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-      }
+  // Nothing changed since the last span if it ends where this one starts
+  if((myCollisionSpanCount != 0) && (myCollisionSpanEnd == myFramePointer))
+  {
+    CollisionSpan& last = myCollisionSpans[myCollisionSpanCount - 1];
 
-      // Let's do a sanity check on our table entries
-      uInt32 s1 = 0, s2 = 0;
-      for(newx = 0; newx < 160; ++newx)
-      {
-        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == -1)
-          ++s1;
-        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == 1)
-          ++s2;
-      }
-      assert((s1 % 4 == 0) && (s2 % 8 == 0));
+    if((last.hpos + last.clocks == hpos) &&
+       (last.enabled == myEnabledObjects) && (last.pfKey == pfKey) &&
+       (last.blMask == myCurrentBLMask) && (last.m0Mask == myCurrentM0Mask) &&
+       (last.m1Mask == myCurrentM1Mask) && (last.p0Mask == myCurrentP0Mask) &&
+       (last.p1Mask == myCurrentP1Mask) && (last.grp0 == myCurrentGRP0) &&
+       (last.grp1 == myCurrentGRP1))
+    {
+      last.clocks += clocks;
+      myCollisionSpanEnd += clocks;
+      return;
     }
   }
+
+  if(myCollisionSpanCount == myMaxCollisionSpans)
+    updateCollisions();
+
+  CollisionSpan& span = myCollisionSpans[myCollisionSpanCount++];
+  span.blMask = myCurrentBLMask;
+  span.m0Mask = myCurrentM0Mask;
+  span.m1Mask = myCurrentM1Mask;
+  span.p0Mask = myCurrentP0Mask;
+  span.p1Mask = myCurrentP1Mask;
+  span.pfKey = pfKey;
+  span.grp0 = myCurrentGRP0;
+  span.grp1 = myCurrentGRP1;
+  span.enabled = myEnabledObjects;
+  span.hpos = hpos;
+  span.clocks = clocks;
+
+  myCollisionSpanEnd = myFramePointer + clocks;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerReflectTable()
+void TIA::updateCollisions()
 {
-  for(uInt16 i = 0; i < 256; ++i)
+  for(uInt32 i = 0; i < myCollisionSpanCount; ++i)
   {
-    uInt8 r = 0;
+    const CollisionSpan& span = myCollisionSpans[i];
+    uInt32 end = span.hpos + span.clocks;
 
-    for(uInt16 t = 1; t <= 128; t *= 2)
+    for(uInt32 hpos = span.hpos; hpos < end; hpos += 32)
     {
-      r = (r << 1) | ((i & t) ? 0x01 : 0x00);
-    }
+      // Only the objects which can still set a latch are needed; those
+      // disabled never can
+      uInt16 missing = ourCollisionTable[span.enabled & 0x3F] & ~myCollision;
+      if(missing == 0)
+        break;
 
-    ourPlayerReflectTable[i] = r;
-  } 
-}
+      uInt32 shown = pixelBits(end - hpos);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayfieldMaskTable()
-{
-  Int32 x;
+      uInt32 pf = (missing & ~ourCollisionTable[0x3F & ~myPFBit]) ?
+          (playfieldBits(span.pfKey, hpos) & shown) : 0;
+      uInt32 bl = (missing & ~ourCollisionTable[0x3F & ~myBLBit]) ?
+          (ballBits(span.blMask + hpos) & shown) : 0;
+      uInt32 p1 = (missing & ~ourCollisionTable[0x3F & ~myP1Bit]) ?
+          (playerBits(span.p1Mask + hpos, span.grp1) & shown) : 0;
+      uInt32 m1 = (missing & ~ourCollisionTable[0x3F & ~myM1Bit]) ?
+          (missleBits(span.m1Mask + hpos) & shown) : 0;
+      uInt32 p0 = (missing & ~ourCollisionTable[0x3F & ~myP0Bit]) ?
+          (playerBits(span.p0Mask + hpos, span.grp0) & shown) : 0;
+      uInt32 m0 = (missing & ~ourCollisionTable[0x3F & ~myM0Bit]) ?
+          (missleBits(span.m0Mask + hpos) & shown) : 0;
 
-  // Compute playfield mask table for non-reflected mode
-  for(x = 0; x < 160; ++x)
-  {
-    if(x < 16)
-      ourPlayfieldTable[0][x] = 0x00001 << (x / 4);
-    else if(x < 48)
-      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 16) / 4);
-    else if(x < 80) 
-      ourPlayfieldTable[0][x] = 0x01000 << ((x - 48) / 4);
-    else if(x < 96) 
-      ourPlayfieldTable[0][x] = 0x00001 << ((x - 80) / 4);
-    else if(x < 128)
-      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 96) / 4);
-    else if(x < 160) 
-      ourPlayfieldTable[0][x] = 0x01000 << ((x - 128) / 4);
+      myCollision |= collisionBits(p0, m0, p1, m1, bl, pf);
+    }
   }
 
-  // Compute playfield mask table for reflected mode
-  for(x = 0; x < 160; ++x)
-  {
-    if(x < 16)
-      ourPlayfieldTable[1][x] = 0x00001 << (x / 4);
-    else if(x < 48)
-      ourPlayfieldTable[1][x] = 0x00800 >> ((x - 16) / 4);
-    else if(x < 80) 
-      ourPlayfieldTable[1][x] = 0x01000 << ((x - 48) / 4);
-    else if(x < 112) 
-      ourPlayfieldTable[1][x] = 0x80000 >> ((x - 80) / 4);
-    else if(x < 144) 
-      ourPlayfieldTable[1][x] = 0x00010 << ((x - 112) / 4);
-    else if(x < 160) 
-      ourPlayfieldTable[1][x] = 0x00008 >> ((x - 144) / 4);
-  }
+  myCollisionSpanCount = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1229,6 +1031,16 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   // Calculate the ending frame pointer value
   uInt8* ending = myFramePointer + clocksToUpdate;
 
+  // Only the collisions are needed if the frame isn't drawn
+  if(!myRenderingFlag)
+  {
+    if(!(myVBLANK & 0x02))
+      recordCollisions(clocksToUpdate, hpos);
+
+    myFramePointer = ending;
+    return;
+  }
+
   // See if we're in the vertical blank region
   if(myVBLANK & 0x02)
   {
@@ -1241,6 +1053,12 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   // Handle all other possible combinations
   else
   {
+    // The collisions are worked out along with the pixels if the game
+    // read them during the last frame, and only when read otherwise
+    bool collide = !myLazyCollisionsFlag;
+    if(myLazyCollisionsFlag)
+      recordCollisions(clocksToUpdate, hpos);
+
     switch(myEnabledObjects | myPlayfieldPriorityAndScore)
     {
       // Background 
@@ -1261,7 +1079,7 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myPFBit: 
       case myPFBit | PriorityBit:
       {
-        uInt32* mask = &myCurrentPFMask[hpos];
+        const uInt32* mask = &myCurrentPFMask[hpos];
 
         // Update a uInt8 at a time until reaching a uInt32 boundary
         for(; ((uintptr_t)myFramePointer & 0x03) && (myFramePointer < ending);
@@ -1282,7 +1100,7 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myPFBit | ScoreBit:
       case myPFBit | ScoreBit | PriorityBit:
       {
-        uInt32* mask = &myCurrentPFMask[hpos];
+        const uInt32* mask = &myCurrentPFMask[hpos];
 
         // Update a uInt8 at a time until reaching a uInt32 boundary
         for(; ((uintptr_t)myFramePointer & 0x03) && (myFramePointer < ending); 
@@ -1308,19 +1126,21 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myP0Bit | PriorityBit:
       case myP0Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mP0 = &myCurrentP0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP0)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 p0 = playerBits(myCurrentP0Mask + hpos, myCurrentGRP0);
+
+          if(!p0)
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mP0 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
+
+          for(; myFramePointer < end; ++myFramePointer, p0 >>= 1)
           {
-            *myFramePointer = (myCurrentGRP0 & *mP0) ? myCOLUP0 : myCOLUBK;
-            ++mP0; ++myFramePointer;
+            *myFramePointer = (p0 & 0x01) ? myCOLUP0 : myCOLUBK;
           }
         }
         break;
@@ -1332,19 +1152,21 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myP1Bit | PriorityBit:
       case myP1Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
+
+          if(!p1)
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mP1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
+
+          for(; myFramePointer < end; ++myFramePointer, p1 >>= 1)
           {
-            *myFramePointer = (myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK;
-            ++mP1; ++myFramePointer;
+            *myFramePointer = (p1 & 0x01) ? myCOLUP1 : myCOLUBK;
           }
         }
         break;
@@ -1356,26 +1178,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myP0Bit | myP1Bit | PriorityBit:
       case myP0Bit | myP1Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mP0 = &myCurrentP0Mask[hpos];
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP0 &&
-              !*(uInt32*)mP1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 p0 = playerBits(myCurrentP0Mask + hpos, myCurrentGRP0);
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
+
+          if(collide && (p0 & p1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myP0Bit | myP1Bit];
+
+          if(!(p0 | p1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mP0 += 4; mP1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (myCurrentGRP0 & *mP0) ? 
-                myCOLUP0 : ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
-
-            if((myCurrentGRP0 & *mP0) && (myCurrentGRP1 & *mP1))
-              myCollision |= ourCollisionTable[myP0Bit | myP1Bit];
 
-            ++mP0; ++mP1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, p0 >>= 1, p1 >>= 1)
+          {
+            *myFramePointer = (p0 & 0x01) ? myCOLUP0 :
+                ((p1 & 0x01) ? myCOLUP1 : myCOLUBK);
           }
         }
         break;
@@ -1387,19 +1209,21 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myM0Bit | PriorityBit:
       case myM0Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mM0 = &myCurrentM0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mM0)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 m0 = missleBits(myCurrentM0Mask + hpos);
+
+          if(!m0)
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mM0 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
+
+          for(; myFramePointer < end; ++myFramePointer, m0 >>= 1)
           {
-            *myFramePointer = *mM0 ? myCOLUP0 : myCOLUBK;
-            ++mM0; ++myFramePointer;
+            *myFramePointer = (m0 & 0x01) ? myCOLUP0 : myCOLUBK;
           }
         }
         break;
@@ -1411,19 +1235,21 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myM1Bit | PriorityBit:
       case myM1Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mM1 = &myCurrentM1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mM1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 m1 = missleBits(myCurrentM1Mask + hpos);
+
+          if(!m1)
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mM1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
+
+          for(; myFramePointer < end; ++myFramePointer, m1 >>= 1)
           {
-            *myFramePointer = *mM1 ? myCOLUP1 : myCOLUBK;
-            ++mM1; ++myFramePointer;
+            *myFramePointer = (m1 & 0x01) ? myCOLUP1 : myCOLUBK;
           }
         }
         break;
@@ -1435,19 +1261,21 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | PriorityBit:
       case myBLBit | ScoreBit | PriorityBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+
+          if(!bl)
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
+
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1)
           {
-            *myFramePointer = *mBL ? myCOLUPF : myCOLUBK;
-            ++mBL; ++myFramePointer;
+            *myFramePointer = (bl & 0x01) ? myCOLUPF : myCOLUBK;
           }
         }
         break;
@@ -1459,24 +1287,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myM0Bit | myM1Bit | PriorityBit:
       case myM0Bit | myM1Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mM0 = &myCurrentM0Mask[hpos];
-        uInt8* mM1 = &myCurrentM1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mM0 && !*(uInt32*)mM1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 m0 = missleBits(myCurrentM0Mask + hpos);
+          uInt32 m1 = missleBits(myCurrentM1Mask + hpos);
+
+          if(collide && (m0 & m1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myM0Bit | myM1Bit];
+
+          if(!(m0 | m1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mM0 += 4; mM1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = *mM0 ? myCOLUP0 : (*mM1 ? myCOLUP1 : myCOLUBK);
-
-            if(*mM0 && *mM1)
-              myCollision |= ourCollisionTable[myM0Bit | myM1Bit];
 
-            ++mM0; ++mM1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, m0 >>= 1, m1 >>= 1)
+          {
+            *myFramePointer = (m0 & 0x01) ? myCOLUP0 :
+                ((m1 & 0x01) ? myCOLUP1 : myCOLUBK);
           }
         }
         break;
@@ -1486,24 +1316,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myM0Bit:
       case myBLBit | myM0Bit | ScoreBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mM0 = &myCurrentM0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL && !*(uInt32*)mM0)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 m0 = missleBits(myCurrentM0Mask + hpos);
+
+          if(collide && (bl & m0 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myM0Bit];
+
+          if(!(bl | m0))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mM0 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (*mM0 ? myCOLUP0 : (*mBL ? myCOLUPF : myCOLUBK));
-
-            if(*mBL && *mM0)
-              myCollision |= ourCollisionTable[myBLBit | myM0Bit];
 
-            ++mBL; ++mM0; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, m0 >>= 1)
+          {
+            *myFramePointer = (m0 & 0x01) ? myCOLUP0 :
+                ((bl & 0x01) ? myCOLUPF : myCOLUBK);
           }
         }
         break;
@@ -1513,24 +1345,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myM0Bit | PriorityBit:
       case myBLBit | myM0Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mM0 = &myCurrentM0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL && !*(uInt32*)mM0)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 m0 = missleBits(myCurrentM0Mask + hpos);
+
+          if(collide && (bl & m0 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myM0Bit];
+
+          if(!(bl | m0))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mM0 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (*mBL ? myCOLUPF : (*mM0 ? myCOLUP0 : myCOLUBK));
 
-            if(*mBL && *mM0)
-              myCollision |= ourCollisionTable[myBLBit | myM0Bit];
-
-            ++mBL; ++mM0; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, m0 >>= 1)
+          {
+            *myFramePointer = (bl & 0x01) ? myCOLUPF :
+                ((m0 & 0x01) ? myCOLUP0 : myCOLUBK);
           }
         }
         break;
@@ -1540,25 +1374,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myM1Bit:
       case myBLBit | myM1Bit | ScoreBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mM1 = &myCurrentM1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL && 
-              !*(uInt32*)mM1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 m1 = missleBits(myCurrentM1Mask + hpos);
+
+          if(collide && (bl & m1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myM1Bit];
+
+          if(!(bl | m1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mM1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (*mM1 ? myCOLUP1 : (*mBL ? myCOLUPF : myCOLUBK));
-
-            if(*mBL && *mM1)
-              myCollision |= ourCollisionTable[myBLBit | myM1Bit];
 
-            ++mBL; ++mM1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, m1 >>= 1)
+          {
+            *myFramePointer = (m1 & 0x01) ? myCOLUP1 :
+                ((bl & 0x01) ? myCOLUPF : myCOLUBK);
           }
         }
         break;
@@ -1568,25 +1403,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myM1Bit | PriorityBit:
       case myBLBit | myM1Bit | ScoreBit | PriorityBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mM1 = &myCurrentM1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL && 
-              !*(uInt32*)mM1)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 m1 = missleBits(myCurrentM1Mask + hpos);
+
+          if(collide && (bl & m1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myM1Bit];
+
+          if(!(bl | m1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mM1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (*mBL ? myCOLUPF : (*mM1 ? myCOLUP1 : myCOLUBK));
-
-            if(*mBL && *mM1)
-              myCollision |= ourCollisionTable[myBLBit | myM1Bit];
 
-            ++mBL; ++mM1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, m1 >>= 1)
+          {
+            *myFramePointer = (bl & 0x01) ? myCOLUPF :
+                ((m1 & 0x01) ? myCOLUP1 : myCOLUBK);
           }
         }
         break;
@@ -1596,25 +1432,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myP1Bit:
       case myBLBit | myP1Bit | ScoreBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP1 && !*(uInt32*)mBL)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
+
+          if(collide && (bl & p1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myP1Bit];
+
+          if(!(bl | p1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mP1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = (myCurrentGRP1 & *mP1) ? myCOLUP1 : 
-                (*mBL ? myCOLUPF : myCOLUBK);
 
-            if(*mBL && (myCurrentGRP1 & *mP1))
-              myCollision |= ourCollisionTable[myBLBit | myP1Bit];
-
-            ++mBL; ++mP1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, p1 >>= 1)
+          {
+            *myFramePointer = (p1 & 0x01) ? myCOLUP1 :
+                ((bl & 0x01) ? myCOLUPF : myCOLUBK);
           }
         }
         break;
@@ -1624,25 +1461,26 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myBLBit | myP1Bit | PriorityBit:
       case myBLBit | myP1Bit | PriorityBit | ScoreBit:
       {
-        uInt8* mBL = &myCurrentBLMask[hpos];
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP1 && !*(uInt32*)mBL)
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
+
+          if(collide && (bl & p1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myBLBit | myP1Bit];
+
+          if(!(bl | p1))
           {
-            *(uInt32*)myFramePointer = myCOLUBK;
-            mBL += 4; mP1 += 4; myFramePointer += 4;
+            fillFrame(end, myCOLUBK);
+            continue;
           }
-          else
-          {
-            *myFramePointer = *mBL ? myCOLUPF : 
-                ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
-
-            if(*mBL && (myCurrentGRP1 & *mP1))
-              myCollision |= ourCollisionTable[myBLBit | myP1Bit];
 
-            ++mBL; ++mP1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, bl >>= 1, p1 >>= 1)
+          {
+            *myFramePointer = (bl & 0x01) ? myCOLUPF :
+                ((p1 & 0x01) ? myCOLUP1 : myCOLUBK);
           }
         }
         break;
@@ -1651,112 +1489,88 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       // Playfield and Player 0 are enabled and playfield priority is not set
       case myPFBit | myP0Bit:
       {
-        uInt32* mPF = &myCurrentPFMask[hpos];
-        uInt8* mP0 = &myCurrentP0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP0)
-          {
-            *(uInt32*)myFramePointer = (myPF & *mPF) ? myCOLUPF : myCOLUBK;
-            mPF += 4; mP0 += 4; myFramePointer += 4;
-          }
-          else
-          {
-            *myFramePointer = (myCurrentGRP0 & *mP0) ? 
-                  myCOLUP0 : ((myPF & *mPF) ? myCOLUPF : myCOLUBK);
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 p0 = playerBits(myCurrentP0Mask + hpos, myCurrentGRP0);
 
-            if((myPF & *mPF) && (myCurrentGRP0 & *mP0))
-              myCollision |= ourCollisionTable[myPFBit | myP0Bit];
+          if(collide && (pf & p0 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myPFBit | myP0Bit];
 
-            ++mPF; ++mP0; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, pf >>= 1, p0 >>= 1)
+          {
+            *myFramePointer = (p0 & 0x01) ? myCOLUP0 :
+                ((pf & 0x01) ? myCOLUPF : myCOLUBK);
           }
         }
-
         break;
       }
 
       // Playfield and Player 0 are enabled and playfield priority is set
       case myPFBit | myP0Bit | PriorityBit:
       {
-        uInt32* mPF = &myCurrentPFMask[hpos];
-        uInt8* mP0 = &myCurrentP0Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP0)
-          {
-            *(uInt32*)myFramePointer = (myPF & *mPF) ? myCOLUPF : myCOLUBK;
-            mPF += 4; mP0 += 4; myFramePointer += 4;
-          }
-          else
-          {
-            *myFramePointer = (myPF & *mPF) ? myCOLUPF : 
-                ((myCurrentGRP0 & *mP0) ? myCOLUP0 : myCOLUBK);
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 p0 = playerBits(myCurrentP0Mask + hpos, myCurrentGRP0);
 
-            if((myPF & *mPF) && (myCurrentGRP0 & *mP0))
-              myCollision |= ourCollisionTable[myPFBit | myP0Bit];
+          if(collide && (pf & p0 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myPFBit | myP0Bit];
 
-            ++mPF; ++mP0; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, pf >>= 1, p0 >>= 1)
+          {
+            *myFramePointer = (pf & 0x01) ? myCOLUPF :
+                ((p0 & 0x01) ? myCOLUP0 : myCOLUBK);
           }
         }
-
         break;
       }
 
       // Playfield and Player 1 are enabled and playfield priority is not set
       case myPFBit | myP1Bit:
       {
-        uInt32* mPF = &myCurrentPFMask[hpos];
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP1)
-          {
-            *(uInt32*)myFramePointer = (myPF & *mPF) ? myCOLUPF : myCOLUBK;
-            mPF += 4; mP1 += 4; myFramePointer += 4;
-          }
-          else
-          {
-            *myFramePointer = (myCurrentGRP1 & *mP1) ? 
-                  myCOLUP1 : ((myPF & *mPF) ? myCOLUPF : myCOLUBK);
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
 
-            if((myPF & *mPF) && (myCurrentGRP1 & *mP1))
-              myCollision |= ourCollisionTable[myPFBit | myP1Bit];
+          if(collide && (pf & p1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myPFBit | myP1Bit];
 
-            ++mPF; ++mP1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, pf >>= 1, p1 >>= 1)
+          {
+            *myFramePointer = (p1 & 0x01) ? myCOLUP1 :
+                ((pf & 0x01) ? myCOLUPF : myCOLUBK);
           }
         }
-
         break;
       }
 
       // Playfield and Player 1 are enabled and playfield priority is set
       case myPFBit | myP1Bit | PriorityBit:
       {
-        uInt32* mPF = &myCurrentPFMask[hpos];
-        uInt8* mP1 = &myCurrentP1Mask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mP1)
-          {
-            *(uInt32*)myFramePointer = (myPF & *mPF) ? myCOLUPF : myCOLUBK;
-            mPF += 4; mP1 += 4; myFramePointer += 4;
-          }
-          else
-          {
-            *myFramePointer = (myPF & *mPF) ? myCOLUPF : 
-                ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
 
-            if((myPF & *mPF) && (myCurrentGRP1 & *mP1))
-              myCollision |= ourCollisionTable[myPFBit | myP1Bit];
+          if(collide && (pf & p1 & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myPFBit | myP1Bit];
 
-            ++mPF; ++mP1; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, pf >>= 1, p1 >>= 1)
+          {
+            *myFramePointer = (pf & 0x01) ? myCOLUPF :
+                ((p1 & 0x01) ? myCOLUP1 : myCOLUBK);
           }
         }
-
         break;
       }
 
@@ -1764,24 +1578,19 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case myPFBit | myBLBit:
       case myPFBit | myBLBit | PriorityBit:
       {
-        uInt32* mPF = &myCurrentPFMask[hpos];
-        uInt8* mBL = &myCurrentBLMask[hpos];
-
-        while(myFramePointer < ending)
+        for(; myFramePointer < ending; hpos += 32)
         {
-          if(!((uintptr_t)myFramePointer & 0x03) && !*(uInt32*)mBL)
-          {
-            *(uInt32*)myFramePointer = (myPF & *mPF) ? myCOLUPF : myCOLUBK;
-            mPF += 4; mBL += 4; myFramePointer += 4;
-          }
-          else
-          {
-            *myFramePointer = ((myPF & *mPF) || *mBL) ? myCOLUPF : myCOLUBK;
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 bl = ballBits(myCurrentBLMask + hpos);
 
-            if((myPF & *mPF) && *mBL)
-              myCollision |= ourCollisionTable[myPFBit | myBLBit];
+          if(collide && (pf & bl & pixelBits(end - myFramePointer)))
+            myCollision |= ourCollisionTable[myPFBit | myBLBit];
 
-            ++mPF; ++mBL; ++myFramePointer;
+          for(; myFramePointer < end; ++myFramePointer, pf >>= 1, bl >>= 1)
+          {
+            *myFramePointer = ((pf | bl) & 0x01) ? myCOLUPF : myCOLUBK;
           }
         }
         break;
@@ -1790,28 +1599,90 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       // Handle all of the other cases
       default:
       {
-        for(; myFramePointer < ending; ++myFramePointer, ++hpos)
-        {
-          uInt8 enabled = (myPF & myCurrentPFMask[hpos]) ? myPFBit : 0;
-
-          if((myEnabledObjects & myBLBit) && myCurrentBLMask[hpos])
-            enabled |= myBLBit;
+        // Each color is drawn over the background where its bits are set
+        uInt32 toPF = myCOLUBK ^ myCOLUPF;
+        uInt32 toP0 = myCOLUBK ^ myCOLUP0;
+        uInt32 toP1 = myCOLUBK ^ myCOLUP1;
 
-          if(myCurrentGRP1 & myCurrentP1Mask[hpos])
-            enabled |= myP1Bit;
+        for(; myFramePointer < ending; hpos += 32)
+        {
+          uInt8* end = myFramePointer + 32 < ending ?
+              myFramePointer + 32 : ending;
+          uInt32 pf = playfieldBits(playfieldKey(), hpos);
+          uInt32 bl = (myEnabledObjects & myBLBit) ?
+              ballBits(myCurrentBLMask + hpos) : 0;
+          uInt32 p1 = playerBits(myCurrentP1Mask + hpos, myCurrentGRP1);
+          uInt32 m1 = (myEnabledObjects & myM1Bit) ?
+              missleBits(myCurrentM1Mask + hpos) : 0;
+          uInt32 p0 = playerBits(myCurrentP0Mask + hpos, myCurrentGRP0);
+          uInt32 m0 = (myEnabledObjects & myM0Bit) ?
+              missleBits(myCurrentM0Mask + hpos) : 0;
+
+          if(collide)
+          {
+            uInt32 shown = pixelBits(end - myFramePointer);
 
-          if((myEnabledObjects & myM1Bit) && myCurrentM1Mask[hpos])
-            enabled |= myM1Bit;
+            myCollision |= collisionBits(p0 & shown, m0 & shown, p1 & shown,
+                                         m1 & shown, bl & shown, pf & shown);
+          }
 
-          if(myCurrentGRP0 & myCurrentP0Mask[hpos])
-            enabled |= myP0Bit;
+          // The pixels shown in each color, from the priority of the objects
+          uInt32 colorPF, colorP0, colorP1;
+          if(myPlayfieldPriorityAndScore & PriorityBit)
+          {
+            colorPF = pf | bl;
+            colorP0 = (p0 | m0) & ~colorPF;
+            colorP1 = (p1 | m1) & ~(colorPF | p0 | m0);
+          }
+          else
+          {
+            colorP0 = p0 | m0;
+            colorP1 = (p1 | m1) & ~colorP0;
+            colorPF = (pf | bl) & ~(colorP0 | colorP1);
+
+            // The playfield has the color of the player on its side
+            if(myPlayfieldPriorityAndScore & ScoreBit)
+            {
+              uInt32 left = (hpos >= 80) ? 0 :
+                  ((hpos + 32 <= 80) ? 0xFFFFFFFF : ((1 << (80 - hpos)) - 1));
+              uInt32 score = colorPF & pf;
+
+              colorPF &= ~score;
+              colorP0 |= score & left;
+              colorP1 |= score & ~left;
+            }
+          }
 
-          if((myEnabledObjects & myM0Bit) && myCurrentM0Mask[hpos])
-            enabled |= myM0Bit;
+          if(!(colorPF | colorP0 | colorP1))
+          {
+            fillFrame(end, myCOLUBK);
+            continue;
+          }
 
-          myCollision |= ourCollisionTable[enabled];
-          *myFramePointer = myColor[myPriorityEncoder[hpos < 80 ? 0 : 1]
-              [enabled | myPlayfieldPriorityAndScore]];
+          // Update a uInt8 at a time until reaching a uInt32 boundary,
+          // then a uInt32 at a time, and the remaining uInt8s
+          for(; ((uintptr_t)myFramePointer & 0x03) && (myFramePointer < end);
+              ++myFramePointer, colorPF >>= 1, colorP0 >>= 1, colorP1 >>= 1)
+          {
+            *myFramePointer = (colorPF & 0x01) ? myCOLUPF :
+                ((colorP0 & 0x01) ? myCOLUP0 :
+                ((colorP1 & 0x01) ? myCOLUP1 : myCOLUBK));
+          }
+          for(; myFramePointer + 4 <= end; myFramePointer += 4,
+              colorPF >>= 4, colorP0 >>= 4, colorP1 >>= 4)
+          {
+            *((uInt32*)myFramePointer) = myCOLUBK ^
+                (toPF & myPixelMasks[colorPF & 0x0F]) ^
+                (toP0 & myPixelMasks[colorP0 & 0x0F]) ^
+                (toP1 & myPixelMasks[colorP1 & 0x0F]);
+          }
+          for(; myFramePointer < end;
+              ++myFramePointer, colorPF >>= 1, colorP0 >>= 1, colorP1 >>= 1)
+          {
+            *myFramePointer = (colorPF & 0x01) ? myCOLUPF :
+                ((colorP0 & 0x01) ? myCOLUP0 :
+                ((colorP1 & 0x01) ? myCOLUP1 : myCOLUBK));
+          }
         }
         break;  
       }
@@ -1894,7 +1765,7 @@ inline void TIA::updateFrame(Int32 clock)
     {
       Int32 blanks = (HBLANK + 8) - clocksFromStartOfScanLine;
       uInt8* ptr = oldFramePointer;
-      while (blanks-- != 0) {
+      while (myRenderingFlag && blanks-- != 0) {
         *ptr++ = 0;
       }
       //memset(oldFramePointer, 0, blanks);
@@ -1910,16 +1781,18 @@ inline void TIA::updateFrame(Int32 clock)
     {
       myFramePointer -= (160 - myFrameWidth - myFrameXStart);
 
+      if(myScanlineListener && myRenderingFlag)
+        myScanlineListener->scanlineDrawn(
+            (myFramePointer - myCurrentFrameBuffer) / myFrameWidth - 1);
+
       // Yes, so set PF mask based on current CTRLPF reflection state 
       myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01];
 
       // TODO: These should be reset right after the first copy of the player
       // has passed.  However, for now we'll just reset at the end of the 
       // scanline since the other way would be to slow (01/21/99).
-      myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-          [0][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
-      myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-          [0][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+      myCurrentP0Mask = playerMask(0, myNUSIZ0 & 0x07, myPOSP0);
+      myCurrentP1Mask = playerMask(0, myNUSIZ1 & 0x07, myPOSP1);
 
       // Handle the "Cosmic Ark" TIA bug if it's enabled
       if(myM0CosmicArkMotionEnabled)
@@ -1938,19 +1811,18 @@ inline void TIA::updateFrame(Int32 clock)
         if(myM0CosmicArkCounter == 1)
         {
           // Stretch this missle so it's at least 2 pixels wide
-          myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-              [myNUSIZ0 & 0x07][((myNUSIZ0 & 0x30) >> 4) | 0x01]
-              [160 - (myPOSM0 & 0xFC)];
+          myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07,
+              ((myNUSIZ0 & 0x30) >> 4) | 0x01, myPOSM0);
         }
         else if(myM0CosmicArkCounter == 2)
         {
           // Missle is disabled on this line 
-          myCurrentM0Mask = &ourDisabledMaskTable[0];
+          myCurrentM0Mask = myDisabledMissleMask;
         }
         else
         {
-          myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-              [myNUSIZ0 & 0x07][(myNUSIZ0 & 0x30) >> 4][160 - (myPOSM0 & 0xFC)];
+          myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07, (myNUSIZ0 & 0x30) >> 4,
+                                       myPOSM0);
         }
       } 
     }
@@ -2002,6 +1874,13 @@ uInt8 TIA::peek(uInt16 addr)
 
   uInt8 noise = mySystem->getDataBusState() & 0x3F;
 
+  // The collision registers are the first eight
+  if((addr & 0x0008) == 0)
+  {
+    updateCollisions();
+    myCollisionsReadFlag = true;
+  }
+
   switch(addr & 0x000f)
   {
     case 0x00:    // CXM0P
@@ -2245,11 +2124,10 @@ void TIA::poke(uInt16 addr, uInt8 value)
       // TODO: Technically the "enable" part, [0], should depend on the current
       // enabled or disabled state.  This mean we probably need a data member
       // to maintain that state (01/21/99).
-      myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-          [0][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
+      myCurrentP0Mask = playerMask(0, myNUSIZ0 & 0x07, myPOSP0);
 
-      myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-          [myNUSIZ0 & 0x07][(myNUSIZ0 & 0x30) >> 4][160 - (myPOSM0 & 0xFC)];
+      myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07, (myNUSIZ0 & 0x30) >> 4,
+                                   myPOSM0);
 
       break;
     }
@@ -2261,11 +2139,10 @@ void TIA::poke(uInt16 addr, uInt8 value)
       // TODO: Technically the "enable" part, [0], should depend on the current
       // enabled or disabled state.  This mean we probably need a data member
       // to maintain that state (01/21/99).
-      myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-          [0][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+      myCurrentP1Mask = playerMask(0, myNUSIZ1 & 0x07, myPOSP1);
 
-      myCurrentM1Mask = &ourMissleMaskTable[myPOSM1 & 0x03]
-          [myNUSIZ1 & 0x07][(myNUSIZ1 & 0x30) >> 4][160 - (myPOSM1 & 0xFC)];
+      myCurrentM1Mask = missleMask(myNUSIZ1 & 0x07, (myNUSIZ1 & 0x30) >> 4,
+                                   myPOSM1);
 
       break;
     }
@@ -2330,8 +2207,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01];
       }
 
-      myCurrentBLMask = &ourBallMaskTable[myPOSBL & 0x03]
-          [(myCTRLPF & 0x30) >> 4][160 - (myPOSBL & 0xFC)];
+      myCurrentBLMask = ballMask((myCTRLPF & 0x30) >> 4, myPOSBL);
 
       break;
     }
@@ -2414,8 +2290,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP0 = newx;
 
         // Setup the mask to skip the first copy of the player
-        myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-            [1][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
+        myCurrentP0Mask = playerMask(1, myNUSIZ0 & 0x07, myPOSP0);
       }
       // Player is being reset in neither the delay nor display section
       else if(when == 0)
@@ -2423,8 +2298,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP0 = newx;
 
         // So we setup the mask to skip the first copy of the player
-        myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-            [1][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
+        myCurrentP0Mask = playerMask(1, myNUSIZ0 & 0x07, myPOSP0);
       }
       // Player is being reset during the delay section of one of its copies
       else if(when == -1)
@@ -2432,8 +2306,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP0 = newx;
 
         // So we setup the mask to display all copies of the player
-        myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-            [0][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
+        myCurrentP0Mask = playerMask(0, myNUSIZ0 & 0x07, myPOSP0);
       }
       break;
     }
@@ -2458,8 +2331,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP1 = newx;
 
         // Setup the mask to skip the first copy of the player
-        myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-            [1][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+        myCurrentP1Mask = playerMask(1, myNUSIZ1 & 0x07, myPOSP1);
       }
       // Player is being reset in neither the delay nor display section
       else if(when == 0)
@@ -2467,8 +2339,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP1 = newx;
 
         // So we setup the mask to skip the first copy of the player
-        myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-            [1][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+        myCurrentP1Mask = playerMask(1, myNUSIZ1 & 0x07, myPOSP1);
       }
       // Player is being reset during the delay section of one of its copies
       else if(when == -1)
@@ -2476,8 +2347,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSP1 = newx;
 
         // So we setup the mask to display all copies of the player
-        myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-            [0][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+        myCurrentP1Mask = playerMask(0, myNUSIZ1 & 0x07, myPOSP1);
       }
       break;
     }
@@ -2495,8 +2365,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSM0 = 8;
       }
  
-      myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-          [myNUSIZ0 & 0x07][(myNUSIZ0 & 0x30) >> 4][160 - (myPOSM0 & 0xFC)];
+      myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07, (myNUSIZ0 & 0x30) >> 4,
+                                   myPOSM0);
       break;
     }
 
@@ -2513,8 +2383,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSM1 = 3;
       }
  
-      myCurrentM1Mask = &ourMissleMaskTable[myPOSM1 & 0x03]
-          [myNUSIZ1 & 0x07][(myNUSIZ1 & 0x30) >> 4][160 - (myPOSM1 & 0xFC)];
+      myCurrentM1Mask = missleMask(myNUSIZ1 & 0x07, (myNUSIZ1 & 0x30) >> 4,
+                                   myPOSM1);
       break;
     }
 
@@ -2553,50 +2423,55 @@ void TIA::poke(uInt16 addr, uInt8 value)
         myPOSBL = 5;
       }
  
-      myCurrentBLMask = &ourBallMaskTable[myPOSBL & 0x03]
-          [(myCTRLPF & 0x30) >> 4][160 - (myPOSBL & 0xFC)];
+      myCurrentBLMask = ballMask((myCTRLPF & 0x30) >> 4, myPOSBL);
       break;
     }
 
     case 0x15:    // Audio control 0
     {
       myAUDC0 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
   
     case 0x16:    // Audio control 1
     {
       myAUDC1 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
   
     case 0x17:    // Audio frequency 0
     {
       myAUDF0 = value & 0x1f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
   
     case 0x18:    // Audio frequency 1
     {
       myAUDF1 = value & 0x1f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
   
     case 0x19:    // Audio volume 0
     {
       myAUDV0 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
   
     case 0x1A:    // Audio volume 1
     {
       myAUDV1 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySpeculativeFlag)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
@@ -2794,8 +2669,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
           middle = 4;
 
         myPOSM0 = (myPOSP0 + middle) % 160;
-        myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-            [myNUSIZ0 & 0x07][(myNUSIZ0 & 0x30) >> 4][160 - (myPOSM0 & 0xFC)];
+        myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07, (myNUSIZ0 & 0x30) >> 4,
+                                     myPOSM0);
       }
 
       myRESMP0 = value & 0x02;
@@ -2822,8 +2697,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
           middle = 4;
 
         myPOSM1 = (myPOSP1 + middle) % 160;
-        myCurrentM1Mask = &ourMissleMaskTable[myPOSM1 & 0x03]
-            [myNUSIZ1 & 0x07][(myNUSIZ1 & 0x30) >> 4][160 - (myPOSM1 & 0xFC)];
+        myCurrentM1Mask = missleMask(myNUSIZ1 & 0x07, (myNUSIZ1 & 0x30) >> 4,
+                                     myPOSM1);
       }
 
       myRESMP1 = value & 0x02;
@@ -2878,18 +2753,15 @@ void TIA::poke(uInt16 addr, uInt8 value)
       else if(myPOSBL < 0)
         myPOSBL += 160;
 
-      myCurrentBLMask = &ourBallMaskTable[myPOSBL & 0x03]
-          [(myCTRLPF & 0x30) >> 4][160 - (myPOSBL & 0xFC)];
+      myCurrentBLMask = ballMask((myCTRLPF & 0x30) >> 4, myPOSBL);
 
-      myCurrentP0Mask = &ourPlayerMaskTable[myPOSP0 & 0x03]
-          [0][myNUSIZ0 & 0x07][160 - (myPOSP0 & 0xFC)];
-      myCurrentP1Mask = &ourPlayerMaskTable[myPOSP1 & 0x03]
-          [0][myNUSIZ1 & 0x07][160 - (myPOSP1 & 0xFC)];
+      myCurrentP0Mask = playerMask(0, myNUSIZ0 & 0x07, myPOSP0);
+      myCurrentP1Mask = playerMask(0, myNUSIZ1 & 0x07, myPOSP1);
 
-      myCurrentM0Mask = &ourMissleMaskTable[myPOSM0 & 0x03]
-          [myNUSIZ0 & 0x07][(myNUSIZ0 & 0x30) >> 4][160 - (myPOSM0 & 0xFC)];
-      myCurrentM1Mask = &ourMissleMaskTable[myPOSM1 & 0x03]
-          [myNUSIZ1 & 0x07][(myNUSIZ1 & 0x30) >> 4][160 - (myPOSM1 & 0xFC)];
+      myCurrentM0Mask = missleMask(myNUSIZ0 & 0x07, (myNUSIZ0 & 0x30) >> 4,
+                                   myPOSM0);
+      myCurrentM1Mask = missleMask(myNUSIZ1 & 0x07, (myNUSIZ1 & 0x30) >> 4,
+                                   myPOSM1);
 
       // Remember what clock HMOVE occured at
       myLastHMOVEClock = clock;
@@ -2912,6 +2784,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
     case 0x2c:    // Clear collision latches
     {
       myCollision = 0;
+      myCollisionSpanCount = 0;
       break;
     }
 
@@ -2925,15 +2798,6 @@ void TIA::poke(uInt16 addr, uInt8 value)
   }
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 TIA::ourBallMaskTable[4][4][320];
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt16 TIA::ourCollisionTable[64];
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 TIA::ourDisabledMaskTable[640];
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Int16 TIA::ourPokeDelayTable[64] = {
    0,  1,  0,  0,  8,  8,  0,  0,  0,  0,  0,  1,  1, -1, -1, -1,
@@ -2942,9 +2806,6 @@ const Int16 TIA::ourPokeDelayTable[64] = {
    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
 };
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 TIA::ourMissleMaskTable[4][8][4][320];
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const bool TIA::ourHMOVEBlankEnableCycles[76] = {
   true,  true,  true,  true,  true,  true,  true,  true,  true,  true,   // 00
@@ -3037,18 +2898,6 @@ const Int32 TIA::ourCompleteMotionTable[76][16] = {
   { 0, -1, -2, -3, -4, -5, -6, -7,  8,  7,  6,  5,  4,  3,  2,  1}  // HBLANK
 };
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 TIA::ourPlayerMaskTable[4][2][8][320];
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Int8 TIA::ourPlayerPositionResetWhenTable[8][160][160];
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 TIA::ourPlayerReflectTable[256];
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 TIA::ourPlayfieldTable[2][160];
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const uInt32 TIA::ourNTSCPalette[256] = {
   0x000000, 0x000000, 0x4a4a4a, 0x4a4a4a,
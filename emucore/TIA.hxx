@@ -173,6 +173,14 @@ class TIA : public Device , public MediaSource
     */
     uInt32 scanlines() const;
 
+    /**
+      Answers whether the last update() returned before the frame was
+      finished (ie, before the 6502 strobed VSYNC).
+
+      @return True if the current frame is incomplete
+    */
+    bool partialFrame() const;
+
     /**
 		Answers the current color clock we've gotten to on this scanline.
 
@@ -185,6 +193,19 @@ class TIA : public Device , public MediaSource
     */
     void setSound(Sound& sound);
 
+    /**
+      Sets the object told about each scanline as soon as it's drawn.
+    */
+    void setScanlineListener(ScanlineListener* listener)
+    {
+      myScanlineListener = listener;
+    }
+
+    /**
+      Sets whether the frames are drawn (see MediaSource::setRendering).
+    */
+    void setRendering(bool enable) { myRenderingFlag = enable; }
+
     enum TIABit {
       P0,   // Descriptor for Player 0 Bit
       P1,   // Descriptor for Player 1 Bit
@@ -215,6 +236,16 @@ class TIA : public Device , public MediaSource
     */
     void enableBits(bool mode) { for(uInt8 i = 0; i < 6; ++i) myBitEnabled[i] = mode; }
 
+    /**
+      Enables/disables speculative emulation.  The frames emulated while
+      it's enabled will be thrown away by loading an earlier state (ie,
+      when running ahead of the real machine), so the sound device is
+      neither fed nor saved and loaded along with the TIA.
+
+      @param mode  Whether the following frames are speculative
+    */
+    void setSpeculative(bool mode) { mySpeculativeFlag = mode; }
+
 #ifdef DEVELOPER_SUPPORT
     /**
       This method should be called to update the media source with
@@ -235,28 +266,6 @@ class TIA : public Device , public MediaSource
     virtual void updateScanlineByTrace(int target);
 #endif
 
-  private:
-    // Compute the ball mask table
-    void computeBallMaskTable();
-
-    // Compute the collision decode table
-    void computeCollisionTable();
-
-    // Compute the missle mask table
-    void computeMissleMaskTable();
-
-    // Compute the player mask table
-    void computePlayerMaskTable();
-
-    // Compute the player position reset when table
-    void computePlayerPositionResetWhenTable();
-
-    // Compute the player reflect table
-    void computePlayerReflectTable();
-
-    // Compute playfield mask table
-    void computePlayfieldMaskTable();
-
   private:
     // Update the current frame buffer up to one scanline
     void updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos);
@@ -279,6 +288,61 @@ class TIA : public Device , public MediaSource
     // Update bookkeeping at end of frame
     void endFrame();
 
+    // Answer the mask of the ball, a missle or a player of the given size
+    // (or number) at the given position, as the bit of its packed mask
+    // table which is shown at the first pixel of the scanline
+    static uInt32 ballMask(uInt32 size, Int32 position)
+    {
+      return size * myMaskRowBits + 160 - position;
+    }
+    static uInt32 missleMask(uInt32 number, uInt32 size, Int32 position)
+    {
+      return (number * 4 + size) * myMaskRowBits + 160 - position;
+    }
+    static uInt32 playerMask(uInt32 enable, uInt32 mode, Int32 position)
+    {
+      return (enable * 8 + mode) * 9 * myMaskRowBits + 160 - position;
+    }
+
+    // Answer 32 bits of a packed mask table from the given bit on
+    static uInt32 maskBits(const uInt32* table, uInt32 bit);
+
+    // Answer the pixels of the ball, a missle, a player and the playfield
+    // from the given mask bit (or horizontal position) on, one bit each
+    // with the leftmost one in bit 0
+    uInt32 ballBits(uInt32 bit) const;
+    static uInt32 missleBits(uInt32 bit);
+    static uInt32 playerBits(uInt32 bit, uInt8 graphics);
+    uInt32 playfieldBits(uInt32 key, uInt32 hpos);
+
+    // Answer the playfield register and reflection state, which
+    // playfieldBits draws the playfield from
+    uInt32 playfieldKey() const;
+
+    // Fill the frame buffer with a color from the frame pointer to the
+    // given end, which becomes the new frame pointer
+    void fillFrame(const uInt8* end, uInt32 color);
+
+    // Answer the collision register bits of the given pixels of each
+    // object, two objects colliding where both their bits are set
+    static uInt16 collisionBits(uInt32 p0, uInt32 m0, uInt32 p1, uInt32 m1,
+                                uInt32 bl, uInt32 pf);
+
+    // Answer the bits of the first given number of pixels of a group
+    static uInt32 pixelBits(uInt32 pixels);
+
+    // Keep the state of the objects over the given pixels of the scanline,
+    // unless they can't set a collision latch which isn't set already
+    void recordCollisions(uInt32 clocks, uInt32 hpos);
+
+    // Set the collision latches for the pixels recorded so far
+    void updateCollisions();
+
+    // Answer true if the given bit of a packed mask table with the given
+    // number of rows can be the mask of an object (i.e. one read from a
+    // state file)
+    static bool validMask(uInt32 mask, uInt32 rows);
+
   private:
     // Console the TIA is associated with
     const Console& myConsole;
@@ -289,6 +353,9 @@ class TIA : public Device , public MediaSource
     // Sound object the TIA is associated with
     Sound* mySound;
 
+    // Object told about the scanlines as they're drawn, if any
+    ScanlineListener* myScanlineListener;
+
   private:
     // Indicates if color loss should be enabled or disabled.  Color loss
     // occurs on PAL (and maybe SECAM) systems when the previous frame
@@ -299,6 +366,12 @@ class TIA : public Device , public MediaSource
     // when VSYNC is strobed or the max scanlines/frame limit is hit.
     bool myPartialFrameFlag;
 
+    // Indicates whether the frames being emulated will be thrown away
+    bool mySpeculativeFlag;
+
+    // Indicates if the frames are drawn into the frame buffers
+    bool myRenderingFlag;
+
   private:
     // Number of frames displayed by this TIA
     int myFrameCounter;
@@ -382,6 +455,18 @@ class TIA : public Device , public MediaSource
       PriorityBit = 0x080     // Bit for Playfield priority
     };
 
+    enum
+    {
+      // A row of a packed mask table has the 320 pixels of a mask, a bit
+      // each, and a word of padding so that 32 bits can be read from any
+      // of the pixels on
+      myMaskRowWords = 11,
+      myMaskRowBits = 32 * myMaskRowWords,
+
+      // Mask of a disabled missle, which is all clear
+      myDisabledMissleMask = 8 * 4 * myMaskRowBits
+    };
+
     // Bitmap of the objects that should be considered while drawing
     uInt8 myEnabledObjects;
 
@@ -394,7 +479,10 @@ class TIA : public Device , public MediaSource
 
     uInt8 myPlayfieldPriorityAndScore;
     uInt32 myColor[4];
-    uInt8 myPriorityEncoder[2][256];
+
+    // The four bytes of pixels selected by each 4 bit index, 0xFF for
+    // the pixels whose bit is set (the first pixel in bit 0)
+    uInt32 myPixelMasks[16];
 
     uInt32& myCOLUBK;       // Background color register (replicated 4 times)
     uInt32& myCOLUPF;       // Playfield color register (replicated 4 times)
@@ -435,6 +523,39 @@ class TIA : public Device , public MediaSource
 
     uInt16 myCollision;    // Collision register
 
+    // The state of the objects over a span of a scanline, kept until the
+    // collision registers are read
+    struct CollisionSpan
+    {
+      uInt32 pfKey;         // See playfieldKey
+      uInt16 blMask, m0Mask, m1Mask, p0Mask, p1Mask;  // All below 65536
+      uInt8 grp0, grp1;
+      uInt8 enabled;        // Enabled objects
+      uInt8 hpos;           // First pixel of the span
+      uInt8 clocks;         // Number of pixels
+    };
+
+    enum
+    {
+      // Enough for the spans of a frame of most games, so that they're
+      // dropped by the next CXCLR instead of being worked out
+      myMaxCollisionSpans = 512
+    };
+
+    // The spans drawn since the collision latches were last updated, in
+    // order, and the frame pointer at the end of the last one (a span
+    // starting there on the same scanline may be extended)
+    CollisionSpan myCollisionSpans[myMaxCollisionSpans];
+    uInt32 myCollisionSpanCount;
+    uInt8* myCollisionSpanEnd;
+
+    // Indicates if the spans are kept for when the collisions are read,
+    // instead of the collisions being worked out as they're drawn
+    bool myLazyCollisionsFlag;
+
+    // Indicates if a collision register was read during this frame
+    bool myCollisionsReadFlag;
+
     // Note that these position registers contain the color clock 
     // on which the object's serial output should begin (0 to 159)
     Int16 myPOSP0;         // Player 0 position register
@@ -452,27 +573,32 @@ class TIA : public Device , public MediaSource
     // reflected if the player is being reflected.
     uInt8 myCurrentGRP1;
 
-    // It's VERY important that the BL, M0, M1, P0 and P1 current
-    // mask pointers are always on a uInt32 boundary.  Otherwise,
-    // the TIA code will fail on a good number of CPUs.
+    // The BL, M0, M1, P0 and P1 current masks are the bits of their
+    // packed mask tables which are shown at the first pixel of the
+    // scanline (see ballMask, missleMask and playerMask)
 
-    // Pointer to the currently active mask array for the ball
-    uInt8* myCurrentBLMask;
+    // Currently active mask for the ball
+    uInt32 myCurrentBLMask;
 
-    // Pointer to the currently active mask array for missle 0
-    uInt8* myCurrentM0Mask;
+    // Currently active mask for missle 0
+    uInt32 myCurrentM0Mask;
 
-    // Pointer to the currently active mask array for missle 1
-    uInt8* myCurrentM1Mask;
+    // Currently active mask for missle 1
+    uInt32 myCurrentM1Mask;
 
-    // Pointer to the currently active mask array for player 0
-    uInt8* myCurrentP0Mask;
+    // Currently active mask for player 0
+    uInt32 myCurrentP0Mask;
 
-    // Pointer to the currently active mask array for player 1
-    uInt8* myCurrentP1Mask;
+    // Currently active mask for player 1
+    uInt32 myCurrentP1Mask;
 
     // Pointer to the currently active mask array for the playfield
-    uInt32* myCurrentPFMask;
+    const uInt32* myCurrentPFMask;
+
+    // The playfield pixels, a bit each, for the playfield register and
+    // reflection state in myPlayfieldBitsKey
+    uInt32 myPlayfieldBits[6];
+    uInt32 myPlayfieldBitsKey;
 
     // Audio values. Only used by TIADebug.
     uInt8 myAUDV0;
@@ -512,20 +638,21 @@ class TIA : public Device , public MediaSource
 	 bool myFrameGreyed;
 
   private:
-    // Ball mask table (entries are true or false)
-    static uInt8 ourBallMaskTable[4][4][320];
+    // The ball, collision, missle, player and playfield tables are
+    // computed at build time by TIATablesGen (see TIATables.cpp)
 
-    // Used to set the collision register to the correct value
-    static uInt16 ourCollisionTable[64];
+    // Ball mask table, a row for each size
+    static const uInt32 ourBallMaskTable[4][myMaskRowWords];
 
-    // A mask table which can be used when an object is disabled
-    static uInt8 ourDisabledMaskTable[640];
+    // Used to set the collision register to the correct value
+    static const uInt16 ourCollisionTable[64];
 
     // Indicates the update delay associated with poking at a TIA address
     static const Int16 ourPokeDelayTable[64];
 
-    // Missle mask table (entries are true or false)
-    static uInt8 ourMissleMaskTable[4][8][4][320];
+    // Missle mask table, a row for each number and size, and then the
+    // row of a disabled missle
+    static const uInt32 ourMissleMaskTable[9][4][myMaskRowWords];
 
     // Used to convert value written in a motion register into 
     // its internal representation
@@ -534,17 +661,22 @@ class TIA : public Device , public MediaSource
     // Indicates if HMOVE blanks should occur for the corresponding cycle
     static const bool ourHMOVEBlankEnableCycles[76];
 
-    // Player mask table
-    static uInt8 ourPlayerMaskTable[4][2][8][320];
+    // Player mask table, with and without the first copy of the player:
+    // for each mode a row of the pixels showing the graphics, and then
+    // a row for each graphics bit
+    static const uInt32 ourPlayerMaskTable[2][8][9][myMaskRowWords];
 
     // Indicates if player is being reset during delay, display or other times
-    static Int8 ourPlayerPositionResetWhenTable[8][160][160];
+    static const Int8 ourPlayerPositionResetWhenTable[8][160][160];
 
     // Used to reflect a players graphics
-    static uInt8 ourPlayerReflectTable[256];
+    static const uInt8 ourPlayerReflectTable[256];
 
     // Playfield mask table for reflected and non-reflected playfields
-    static uInt32 ourPlayfieldTable[2][160];
+    static const uInt32 ourPlayfieldTable[2][160];
+
+    // Spreads each bit of a byte over 4 bits, for the playfield pixels
+    static const uInt32 ourPlayfieldExpandTable[256];
 
     // Table of RGB values for NTSC
     static const uInt32 ourNTSCPalette[256];
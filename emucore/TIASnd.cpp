@@ -16,9 +16,306 @@
 // $Id: TIASnd.cxx,v 1.4 2006/01/06 00:31:56 stephena Exp $
 //============================================================================
 
+#include <math.h>
+#include <string.h>
+
 #include "System.hxx"
 #include "TIASnd.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Clocks a channel's poly registers the way the given AUDC value does;
+// it's only run to fill in the table below
+static void clockPoly(uInt8 audc, uInt8& p4, uInt8& p5)
+{
+  switch(audc)
+  {
+    case 0x00:    // Set to 1
+    {
+      // Shift a 1 into the 4-bit register each clock
+      p4 = (p4 << 1) | 0x01;
+      break;
+    }
+
+    case 0x01:    // 4 bit poly
+    {
+      // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+      p4 = (p4 & 0x0f) ? 
+          ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+          ((p4 & 0x04) ? 1 : 0))) : 1;
+      break;
+    }
+
+    case 0x02:    // div 31 -> 4 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+        p4 = (p4 & 0x0f) ? 
+            ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+            ((p4 & 0x04) ? 1 : 0))) : 1;
+      }
+      break;
+    }
+
+    case 0x03:    // 5 bit poly -> 4 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // P5 clocks the 4 bit poly
+      if(p5 & 0x10)
+      {
+        // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+        p4 = (p4 & 0x0f) ? 
+            ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+            ((p4 & 0x04) ? 1 : 0))) : 1;
+      }
+      break;
+    }
+
+    case 0x04:    // div 2
+    {
+      // Clock P4 toggling the lower bit (divide by 2) 
+      p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      break;
+    }
+
+    case 0x05:    // div 2
+    {
+      // Clock P4 toggling the lower bit (divide by 2) 
+      p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      break;
+    }
+
+    case 0x06:    // div 31 -> div 2
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Clock P4 toggling the lower bit (divide by 2) 
+        p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x07:    // 5 bit poly -> div 2
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // P5 clocks the 4 bit register
+      if(p5 & 0x10)
+      {
+        // Clock P4 toggling the lower bit (divide by 2) 
+        p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x08:    // 9 bit poly
+    {
+      // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
+      p5 = ((p5 & 0x1f) || (p4 & 0x0f)) ?
+        ((p5 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+        ((p5 & 0x10) ? 1 : 0))) : 1;
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x09:    // 5 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Clock value out of P5 into P4 with no modification
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x0a:    // div 31
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Feed bit 4 of P5 into P4 (this will toggle back and forth)
+        p4 = (p4 << 1) | ((p5 & 0x10) ? 1 : 0);
+      }
+      break;
+    }
+
+    case 0x0b:    // Set last 4 bits to 1
+    {
+      // A 1 is shifted into the 4-bit register each clock
+      p4 = (p4 << 1) | 0x01;
+      break;
+    }
+
+    case 0x0c:    // div 6
+    {
+      // Use 4-bit register to generate sequence 000111000111
+      p4 = (~p4 << 1) |
+          ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      break;
+    }
+
+    case 0x0d:    // div 6
+    {
+      // Use 4-bit register to generate sequence 000111000111
+      p4 = (~p4 << 1) |
+          ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      break;
+    }
+
+    case 0x0e:    // div 31 -> div 6
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Use 4-bit register to generate sequence 000111000111
+        p4 = (~p4 << 1) |
+            ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x0f:    // poly 5 -> div 6
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Use poly 5 to clock 4-bit div register
+      if(p5 & 0x10)
+      {
+        // Use 4-bit register to generate sequence 000111000111
+        p4 = (~p4 << 1) |
+            ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      }
+      break;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The next poly state after a divider pulse, for each AUDC value and
+// state (the 4 and 5 bit registers are all that's needed to go on)
+static uInt16 ourPolyTable[16][TIASOUND_POLY_STATES];
+static bool ourPolyTableReady = false;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void buildPolyTable()
+{
+  for(uInt32 audc = 0; audc < 16; ++audc)
+  {
+    for(uInt32 state = 0; state < TIASOUND_POLY_STATES; ++state)
+    {
+      uInt8 p4 = state & 0x0f;
+      uInt8 p5 = state >> 4;
+      clockPoly(audc, p4, p5);
+      ourPolyTable[audc][state] = ((p5 & 0x1f) << 4) | (p4 & 0x0f);
+    }
+  }
+  ourPolyTableReady = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The band limited step responses, as the differences between consecutive
+// output samples, for each distance (in phases) from the step to the next
+// output sample.  The output is delayed by half the taps to make room for
+// the samples before the step.
+static Int32 ourBlepTable[TIASOUND_BLEP_PHASES + 1][TIASOUND_BLEP_TAPS];
+static bool ourBlepTableReady = false;
+
+// Cutoff of the filter, relative to the output frequency
+#define TIASOUND_BLEP_CUTOFF  0.45
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void buildBlepTable()
+{
+  const double half = TIASOUND_BLEP_TAPS / 2;
+
+  for(uInt32 phase = 0; phase <= TIASOUND_BLEP_PHASES; ++phase)
+  {
+    double kernel[TIASOUND_BLEP_TAPS];
+    double sum = 0.0;
+
+    // Blackman windowed sinc
+    for(uInt32 i = 0; i < TIASOUND_BLEP_TAPS; ++i)
+    {
+      double x = i - half + (double)phase / TIASOUND_BLEP_PHASES;
+      double s = 2.0 * TIASOUND_BLEP_CUTOFF * x;
+      double sinc = (x == 0.0) ? 1.0 : sin(M_PI * s) / (M_PI * s);
+      double window = 0.42 + 0.5 * cos(M_PI * x / half) +
+          0.08 * cos(2.0 * M_PI * x / half);
+
+      kernel[i] = sinc * window;
+      sum += kernel[i];
+    }
+
+    // Each step has to add up to exactly its size, or the level drifts
+    Int32 total = 0;
+    for(uInt32 i = 0; i < TIASOUND_BLEP_TAPS; ++i)
+    {
+      ourBlepTable[phase][i] = (Int32)floor(kernel[i] / sum *
+          (1 << TIASOUND_BLEP_SHIFT) + 0.5);
+      total += ourBlepTable[phase][i];
+    }
+    ourBlepTable[phase][TIASOUND_BLEP_TAPS / 2] +=
+        (1 << TIASOUND_BLEP_SHIFT) - total;
+  }
+  ourBlepTableReady = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Answers the scale from the output counter to a step table phase (8.24)
+static uInt32 blepPhaseScale(Int32 tiaFrequency)
+{
+  return ((TIASOUND_BLEP_PHASES << 24) + tiaFrequency / 2) / tiaFrequency;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Answers the level a running sum of steps stands for
+static inline Int32 blepLevel(Int32 sum)
+{
+  return (sum + (1 << (TIASOUND_BLEP_SHIFT - 1))) >> TIASOUND_BLEP_SHIFT;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The steps ring a little past the levels they go between, so the samples
+// are clamped
+static inline Int16 clampSample(Int32 value)
+{
+  return (value < -32768) ? -32768 : ((value > 32767) ? 32767 : value);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIASound::TIASound(Int32 outputFrequency, Int32 tiaFrequency, uInt32 channels)
   : myOutputFrequency(outputFrequency),
@@ -26,8 +323,18 @@ TIASound::TIASound(Int32 outputFrequency, Int32 tiaFrequency, uInt32 channels)
     myChannels(channels),
     myOutputCounter(0),
     myVolumePercentage(100),
-    myVolumeClip(128)
+    myVolumeClip(true),
+    myPanNear(1 << 15),
+    myPanFar(0),
+    myBandLimited(false),
+    myBlepPhaseScale(blepPhaseScale(tiaFrequency))
 {
+  if(!ourPolyTableReady)
+    buildPolyTable();
+  if(!ourBlepTableReady)
+    buildBlepTable();
+
+  buildVolumeTable();
   reset();
 }
 
@@ -40,10 +347,12 @@ TIASound::~TIASound()
 void TIASound::reset()
 {
   myAUDC[0] = myAUDC[1] = myAUDF[0] = myAUDF[1] = myAUDV[0] = myAUDV[1] = 0;
-  myP4[0] = myP5[0] = myP4[1] = myP5[1] = 1;
+  myPolyState[0] = myPolyState[1] = (0x01 << 4) | 0x01;
   myFreqDiv[0].set(0);
   myFreqDiv[1].set(0);
   myOutputCounter = 0;
+
+  clearSteps();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,18 +365,57 @@ void TIASound::outputFrequency(Int32 freq)
 void TIASound::tiaFrequency(Int32 freq)
 {
   myTIAFrequency = freq;
+  myBlepPhaseScale = blepPhaseScale(freq);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::channels(uInt32 number)
 {
-  myChannels = number == 2 ? 2 : 1;
+  number = number == 2 ? 2 : 1;
+
+  // The rings hold the channels mixed in mono but not in stereo
+  if(number != myChannels)
+    clearSteps();
+
+  myChannels = number;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::clipVolume(bool clip)
 {
-  myVolumeClip = clip ? 128 : 0;
+  myVolumeClip = clip;
+  buildVolumeTable();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::stereoWidth(uInt32 percent)
+{
+  if(percent > 100)
+    percent = 100;
+
+  myPanNear = ((100 + percent) << 15) / 200;
+  myPanFar = (1 << 15) - myPanNear;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::bandLimit(bool enable)
+{
+  if(enable == myBandLimited)
+    return;
+
+  // Start from silence, which the first samples step up from
+  myBandLimited = enable;
+  clearSteps();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::clearSteps()
+{
+  memset(myBlepRing, 0, sizeof(myBlepRing));
+  myBlepPosition = 0;
+  myBlepSum[0] = myBlepSum[1] = 0;
+  myBlepLevel[0] = myBlepLevel[1] = 0;
+  myBlepPending = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -137,246 +485,281 @@ uInt8 TIASound::get(uInt16 address)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::volume(uInt32 percent)
 {
-  if((percent >= 0) && (percent <= 100))
+  if((percent <= 100) && (percent != myVolumePercentage))
+  {
     myVolumePercentage = percent;
+    buildVolumeTable();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIASound::process(uInt8* buffer, uInt32 samples)
+void TIASound::buildVolumeTable()
 {
-  Int32 v0 = ((myAUDV[0] << 2) * myVolumePercentage) / 100;
-  Int32 v1 = ((myAUDV[1] << 2) * myVolumePercentage) / 100;
+  // Both channels at full volume come close to the full 16-bit range,
+  // or half of it when clipping
+  for(uInt32 v = 0; v < 16; ++v)
+    myVolumeTable[v] = ((v << 2) * myVolumePercentage << (myVolumeClip ? 7 : 8))
+        / 100;
+}
 
-  // Loop until the sample buffer is full
-  while(samples > 0)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIASound::render(Int16*& buffer, uInt32& samples, uInt32 clocks,
+                        Int32 v0, Int32 v1)
+{
+  // Samples are output each time the counter goes past the TIA frequency,
+  // after the clock that brought it there
+  Int32 total = myOutputCounter + (Int32)clocks * myOutputFrequency;
+  uInt32 count = 0;
+
+  if(clocks == 1)
+  {
+    // A single clock (e.g. pulses on every clock) outputs a sample or two
+    // at most, which isn't worth dividing for
+    while((total >= myTIAFrequency) && (count < samples))
+    {
+      total -= myTIAFrequency;
+      ++count;
+    }
+    myOutputCounter = total;
+  }
+  else
   {
-    // Process both sound channels
-    for(uInt32 c = 0; c < 2; ++c)
+    count = total / myTIAFrequency;
+    if(count >= samples)
     {
-      // Update P4 & P5 registers for channel if freq divider outputs a pulse
-      if((myFreqDiv[c].clock()))
+      // Stop at the clock the last sample is output after
+      count = samples;
+      Int32 needed = (Int32)count * myTIAFrequency - myOutputCounter;
+      clocks = (needed <= 0) ? 1 :
+          (needed + myOutputFrequency - 1) / myOutputFrequency;
+      total = myOutputCounter + (Int32)clocks * myOutputFrequency;
+    }
+    myOutputCounter = total - (Int32)count * myTIAFrequency;
+  }
+  samples -= count;
+
+  if(myBandLimited)
+  {
+    integrateSteps(buffer, count);
+    return clocks;
+  }
+
+  Int32 left, right;
+  mix(v0, v1, left, right);
+
+  if(myChannels == 1)
+  {
+    for(uInt32 i = 0; i < count; ++i)
+      *(buffer++) = left;
+  }
+  else
+  {
+    for(uInt32 i = 0; i < count; ++i)
+    {
+      *(buffer++) = left;
+      *(buffer++) = right;
+    }
+  }
+
+  return clocks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::mix(Int32 v0, Int32 v1, Int32& left, Int32& right) const
+{
+  Int32 out0 = (myPolyState[0] & 0x08) ? v0 : 0;
+  Int32 out1 = (myPolyState[1] & 0x08) ? v1 : 0;
+
+  if(myChannels == 1)
+  {
+    left = out0 + out1;
+    right = 0;
+  }
+  else
+  {
+    left = (out0 * myPanNear + out1 * myPanFar) >> 15;
+    right = (out0 * myPanFar + out1 * myPanNear) >> 15;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 TIASound::levelChange(uInt32 channel, Int32 volume)
+{
+  Int32 level = (myPolyState[channel] & 0x08) ? volume : 0;
+  Int32 delta = level - myBlepLevel[channel];
+  myBlepLevel[channel] = level;
+
+  return delta;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline void addStep(Int32* ring, const Int32* kernel, Int32 delta)
+{
+  for(uInt32 i = 0; i < TIASOUND_BLEP_TAPS; ++i)
+    ring[i] += delta * kernel[i];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::insertSteps(Int32 delta0, Int32 delta1)
+{
+  // In mono the channels add up, so steps on the same clock are one step
+  if(myChannels == 1)
+  {
+    delta0 += delta1;
+    delta1 = 0;
+  }
+  if(delta0 == 0 && delta1 == 0)
+    return;
+
+  // The next sample is output when the counter reaches the TIA frequency
+  uInt32 phase = 0;
+  if(myOutputCounter < myTIAFrequency)
+    phase = ((myTIAFrequency - myOutputCounter) * myBlepPhaseScale +
+        (1 << 23)) >> 24;
+  const Int32* kernel = ourBlepTable[phase];
+
+  if(delta0 != 0)
+    addStep(myBlepRing[0] + myBlepPosition, kernel, delta0);
+  if(delta1 != 0)
+    addStep(myBlepRing[1] + myBlepPosition, kernel, delta1);
+
+  myBlepPending = TIASOUND_BLEP_TAPS;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::integrateSteps(Int16*& buffer, uInt32 count)
+{
+  // Only the samples the last steps reach need the rings, the rest are
+  // flat like the point sampled ones
+  uInt32 stepped = (count < myBlepPending) ? count : myBlepPending;
+  uInt32 flat = count - stepped;
+  myBlepPending -= stepped;
+
+  uInt32 rings = (myChannels == 2) ? 2 : 1;
+  while(stepped > 0)
+  {
+    // Move the steps added past the end of the rings to the front
+    if(myBlepPosition == TIASOUND_BLEP_RING)
+    {
+      for(uInt32 r = 0; r < rings; ++r)
       {
-        switch(myAUDC[c])
-        {
-          case 0x00:    // Set to 1
-          {
-            // Shift a 1 into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x01:    // 4 bit poly
-          {
-            // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-            myP4[c] = (myP4[c] & 0x0f) ? 
-                ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            break;
-          }
-
-          case 0x02:    // div 31 -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x03:    // 5 bit poly -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit poly
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x04:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x05:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x06:    // div 31 -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x07:    // 5 bit poly -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit register
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x08:    // 9 bit poly
-          {
-            // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
-            myP5[c] = ((myP5[c] & 0x1f) || (myP4[c] & 0x0f)) ?
-              ((myP5[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-              ((myP5[c] & 0x10) ? 1 : 0))) : 1;
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x09:    // 5 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Clock value out of P5 into P4 with no modification
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x0a:    // div 31
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Feed bit 4 of P5 into P4 (this will toggle back and forth)
-              myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x10) ? 1 : 0);
-            }
-            break;
-          }
-
-          case 0x0b:    // Set last 4 bits to 1
-          {
-            // A 1 is shifted into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x0c:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
-
-          case 0x0d:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
-
-          case 0x0e:    // div 31 -> div 6
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x0f:    // poly 5 -> div 6
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Use poly 5 to clock 4-bit div register
-            if(myP5[c] & 0x10)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
-          }
-        }
+        Int32* ring = myBlepRing[r];
+        memcpy(ring, ring + TIASOUND_BLEP_RING,
+               TIASOUND_BLEP_TAPS * sizeof(Int32));
+        memset(ring + TIASOUND_BLEP_RING, 0,
+               TIASOUND_BLEP_TAPS * sizeof(Int32));
       }
+      myBlepPosition = 0;
     }
 
-    myOutputCounter += myOutputFrequency;
-  
+    uInt32 n = TIASOUND_BLEP_RING - myBlepPosition;
+    if(n > stepped)
+      n = stepped;
+    stepped -= n;
+
     if(myChannels == 1)
     {
-      // Handle mono sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      Int32* ring = myBlepRing[0] + myBlepPosition;
+      Int32 sum = myBlepSum[0];
+      for(uInt32 i = 0; i < n; ++i)
       {
-        *(buffer++) = (((myP4[0] & 8) ? v0 : 0) + 
-            ((myP4[1] & 8) ? v1 : 0)) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        sum += ring[i];
+        ring[i] = 0;
+        *(buffer++) = clampSample(blepLevel(sum));
       }
+      myBlepSum[0] = sum;
     }
     else
     {
-      // Handle stereo sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      // The channels are panned once their steps are added up
+      Int32* ring0 = myBlepRing[0] + myBlepPosition;
+      Int32* ring1 = myBlepRing[1] + myBlepPosition;
+      Int32 sum0 = myBlepSum[0];
+      Int32 sum1 = myBlepSum[1];
+      for(uInt32 i = 0; i < n; ++i)
       {
-        *(buffer++) = ((myP4[0] & 8) ? v0 : 0) + myVolumeClip;
-        *(buffer++) = ((myP4[1] & 8) ? v1 : 0) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        sum0 += ring0[i];
+        sum1 += ring1[i];
+        ring0[i] = ring1[i] = 0;
+
+        Int32 out0 = blepLevel(sum0);
+        Int32 out1 = blepLevel(sum1);
+        *(buffer++) = clampSample((out0 * myPanNear + out1 * myPanFar) >> 15);
+        *(buffer++) = clampSample((out0 * myPanFar + out1 * myPanNear) >> 15);
       }
+      myBlepSum[0] = sum0;
+      myBlepSum[1] = sum1;
+    }
+    myBlepPosition += n;
+  }
+
+  // The flat samples don't use the rings, so their position stays put
+  if(myChannels == 1)
+  {
+    Int16 value = clampSample(blepLevel(myBlepSum[0]));
+    for(uInt32 i = 0; i < flat; ++i)
+      *(buffer++) = value;
+  }
+  else
+  {
+    Int32 out0 = blepLevel(myBlepSum[0]);
+    Int32 out1 = blepLevel(myBlepSum[1]);
+    Int16 left = clampSample((out0 * myPanNear + out1 * myPanFar) >> 15);
+    Int16 right = clampSample((out0 * myPanFar + out1 * myPanNear) >> 15);
+    for(uInt32 i = 0; i < flat; ++i)
+    {
+      *(buffer++) = left;
+      *(buffer++) = right;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::process(Int16* buffer, uInt32 samples)
+{
+  Int32 v0 = myVolumeTable[myAUDV[0]];
+  Int32 v1 = myVolumeTable[myAUDV[1]];
+
+  // A new volume takes effect right away
+  if(myBandLimited)
+    insertSteps(levelChange(0, v0), levelChange(1, v1));
+
+  // Loop until the sample buffer is full
+  while(samples > 0)
+  {
+    // The output only changes on the clocks where a divider outputs a
+    // pulse, so the samples in between are rendered in one go
+    uInt32 n0 = myFreqDiv[0].clocksToPulse();
+    uInt32 n1 = myFreqDiv[1].clocksToPulse();
+    uInt32 quiet = ((n0 < n1) ? n0 : n1) - 1;
+
+    if(quiet > 0)
+    {
+      uInt32 clocks = render(buffer, samples, quiet, v0, v1);
+      myFreqDiv[0].skip(clocks);
+      myFreqDiv[1].skip(clocks);
+
+      if(samples == 0)
+        break;
+    }
+
+    // Step the poly registers of the channels being pulsed; only their
+    // levels can change
+    Int32 delta0 = 0, delta1 = 0;
+    if(myFreqDiv[0].clock())
+    {
+      myPolyState[0] = ourPolyTable[myAUDC[0]][myPolyState[0]];
+      if(myBandLimited)
+        delta0 = levelChange(0, v0);
+    }
+    if(myFreqDiv[1].clock())
+    {
+      myPolyState[1] = ourPolyTable[myAUDC[1]][myPolyState[1]];
+      if(myBandLimited)
+        delta1 = levelChange(1, v1);
     }
+    if(delta0 != 0 || delta1 != 0)
+      insertSteps(delta0, delta1);
+    render(buffer, samples, 1, v0, v1);
   }
 }
@@ -21,6 +21,16 @@
 
 #include "bspf.hxx"
 
+// Number of states of a channel's 4 and 5 bit poly registers together
+#define TIASOUND_POLY_STATES 512
+
+// Band limited synthesis: every change of level is added to the output
+// as a windowed sinc step, taken from a table of sub-sample phases
+#define TIASOUND_BLEP_PHASES  32
+#define TIASOUND_BLEP_TAPS    8
+#define TIASOUND_BLEP_RING    64    // Samples between moves of the ring
+#define TIASOUND_BLEP_SHIFT   14    // Fixed point bits of the steps
+
 /**
   This class implements a fairly accurate emulation of the TIA sound
   hardware.
@@ -68,6 +78,18 @@ class TIASound
     */
     void clipVolume(bool clip);
 
+    /**
+      Set how far apart the two sound channels are panned in stereo, from
+      0 (both in the center) to 100 (channel 0 left, channel 1 right)
+    */
+    void stereoWidth(uInt32 percent);
+
+    /**
+      Selects band limited synthesis, where the output is filtered to the
+      output frequency instead of point sampling the TIA's, which aliases.
+    */
+    void bandLimit(bool enable);
+
   public:
     /**
       Sets the specified sound register to the given value
@@ -85,14 +107,14 @@ class TIASound
     uInt8 get(uInt16 address);
 
     /**
-      Create sound samples based on the current sound register settings
-      in the specified buffer. NOTE: If channels is set to stereo then
-      the buffer will need to be twice as long as the number of samples.
+      Create signed 16-bit sound samples based on the current sound register
+      settings in the specified buffer. NOTE: If channels is set to stereo
+      then the buffer will need to be twice as long as the number of samples.
 
       @param buffer The location to store generated samples
       @param samples The number of samples to generate
     */
-    void process(uInt8* buffer, uInt32 samples);
+    void process(Int16* buffer, uInt32 samples);
 
     /**
       Set the volume of the samples created (0-100)
@@ -100,6 +122,49 @@ class TIASound
     void volume(uInt32 percent);
 
   private:
+    /**
+      Renders the samples for the given number of TIA clocks, during which
+      the output doesn't change, stopping early if the buffer gets full.
+
+      @return The number of clocks rendered
+    */
+    uInt32 render(Int16*& buffer, uInt32& samples, uInt32 clocks,
+                  Int32 v0, Int32 v1);
+
+    /**
+      Answers the output levels (the left and right ones in stereo) for
+      the given channel volumes and the current poly registers.
+    */
+    void mix(Int32 v0, Int32 v1, Int32& left, Int32& right) const;
+
+    /**
+      Updates the level of the given channel from its poly register.
+
+      @return The change of the level
+    */
+    Int32 levelChange(uInt32 channel, Int32 volume);
+
+    /**
+      Adds the band limited steps of the channels' level changes to the
+      output, at the current position of the output counter.
+    */
+    void insertSteps(Int32 delta0, Int32 delta1);
+
+    /**
+      Outputs the given number of band limited samples.
+    */
+    void integrateSteps(Int16*& buffer, uInt32 count);
+
+    /**
+      Drops the band limited steps, so the output starts from silence.
+    */
+    void clearSteps();
+
+    /**
+      Fills in the volume table for the current volume and clipping.
+    */
+    void buildVolumeTable();
+
     /**
       Frequency divider class which outputs 1 after "divide-by" clocks. This
       is used to divide the main frequency by the values 1 to 32.
@@ -127,6 +192,19 @@ class TIASound
           return false;
         }
 
+        // Answers the number of clocks up to and including the next pulse
+        uInt32 clocksToPulse() const
+        {
+          return (myCounter >= myDivideByValue) ? 1 :
+              myDivideByValue - myCounter + 1;
+        }
+
+        // Clocks the divider a number of times short of the next pulse
+        void skip(uInt32 clocks)
+        {
+          myCounter += clocks;
+        }
+
       private:
         uInt32 myDivideByValue;
         uInt32 myCounter;
@@ -138,15 +216,42 @@ class TIASound
     uInt8 myAUDV[2];
 
     FreqDiv myFreqDiv[2];    // Frequency dividers
-    uInt8 myP4[2];           // 4-bit register LFSR (lower 4 bits used)
-    uInt8 myP5[2];           // 5-bit register LFSR (lower 5 bits used)
+    uInt16 myPolyState[2];   // 5-bit register LFSR in bits 8-4, 4-bit
+                             // register LFSR in bits 3-0
 
     Int32  myOutputFrequency;
     Int32  myTIAFrequency;
     uInt32 myChannels;
     Int32  myOutputCounter;
     uInt32 myVolumePercentage;
-    uInt8  myVolumeClip;
+    bool   myVolumeClip;
+
+    // Sample amplitude for each AUDV value, at the current volume
+    Int32  myVolumeTable[16];
+
+    // Share of a channel on its own side and on the other one in stereo
+    // (1.15 fixed point)
+    Int32  myPanNear;
+    Int32  myPanFar;
+
+    // Band limited synthesis: the differences each output sample adds to
+    // the running sum, for the next samples, and the level reached once
+    // they're all added.  They're kept per TIA channel and panned when
+    // output; in mono both channels share the first ring.  The steps are
+    // added past the position without wrapping, and the tail is moved to
+    // the front once the position reaches the end.
+    bool   myBandLimited;
+    Int32  myBlepRing[2][TIASOUND_BLEP_RING + TIASOUND_BLEP_TAPS];
+    uInt32 myBlepPosition;
+    Int32  myBlepSum[2];
+    Int32  myBlepLevel[2];
+
+    // Number of samples the last step still changes; the level is flat
+    // after them and the rings are empty
+    uInt32 myBlepPending;
+
+    // Converts the output counter to a phase of the step table (8.24)
+    uInt32 myBlepPhaseScale;
 };
 
 #endif
@@ -0,0 +1,626 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Build tool which computes the TIA mask tables and writes them, as
+  const data, to the C++ source file given on the command line.  It runs
+  on the build host, so the tables are neither computed when a console
+  is created nor stored in writable memory:
+
+    TIATablesGen emucore/TIATables.cpp
+
+  The ball, missle and player masks are computed a byte per pixel, as
+  the TIA class used to, and written packed a bit per pixel.
+*/
+
+#include <cassert>
+#include <cstdio>
+
+#include "bspf.hxx"
+
+// Same values as the object bits of the TIA class
+enum
+{
+  myP0Bit = 0x01,         // Bit for Player 0
+  myM0Bit = 0x02,         // Bit for Missle 0
+  myP1Bit = 0x04,         // Bit for Player 1
+  myM1Bit = 0x08,         // Bit for Missle 1
+  myBLBit = 0x10,         // Bit for Ball
+  myPFBit = 0x20          // Bit for Playfield
+};
+
+static uInt8 ourBallMaskTable[4][320];
+static uInt16 ourCollisionTable[64];
+static uInt8 ourMissleMaskTable[8][4][320];
+static uInt8 ourPlayerMaskTable[2][8][320];
+static Int8 ourPlayerPositionResetWhenTable[8][160][160];
+static uInt8 ourPlayerReflectTable[256];
+static uInt32 ourPlayfieldTable[2][160];
+
+// Words of a row of the packed mask tables: the 320 pixels of a row and
+// a word of padding, so that 32 bits can be read from any pixel on
+#define MASK_ROW_WORDS  11
+
+static uInt32 ourPackedBallMaskTable[4][MASK_ROW_WORDS];
+static uInt32 ourPackedMissleMaskTable[9][4][MASK_ROW_WORDS];
+static uInt32 ourPackedPlayerMaskTable[2][8][9][MASK_ROW_WORDS];
+static uInt32 ourPlayfieldExpandTable[256];
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computeBallMaskTable()
+{
+  for(Int32 size = 0; size < 4; ++size)
+  {
+    Int32 x;
+
+    // Set all of the masks to false to start with
+    for(x = 0; x < 160; ++x)
+    {
+      ourBallMaskTable[size][x] = false;
+    }
+
+    // Set the necessary fields true
+    for(x = 0; x < 160 + 8; ++x)
+    {
+      if((x >= 0) && (x < (1 << size)))
+      {
+        ourBallMaskTable[size][x % 160] = true;
+      }
+    }
+
+    // Copy fields into the wrap-around area of the mask
+    for(x = 0; x < 160; ++x)
+    {
+      ourBallMaskTable[size][x + 160] = ourBallMaskTable[size][x];
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computeCollisionTable()
+{
+  for(uInt8 i = 0; i < 64; ++i)
+  { 
+    ourCollisionTable[i] = 0;
+
+    if((i & myM0Bit) && (i & myP1Bit))    // M0-P1
+      ourCollisionTable[i] |= 0x0001;
+
+    if((i & myM0Bit) && (i & myP0Bit))    // M0-P0
+      ourCollisionTable[i] |= 0x0002;
+
+    if((i & myM1Bit) && (i & myP0Bit))    // M1-P0
+      ourCollisionTable[i] |= 0x0004;
+
+    if((i & myM1Bit) && (i & myP1Bit))    // M1-P1
+      ourCollisionTable[i] |= 0x0008;
+
+    if((i & myP0Bit) && (i & myPFBit))    // P0-PF
+      ourCollisionTable[i] |= 0x0010;
+
+    if((i & myP0Bit) && (i & myBLBit))    // P0-BL
+      ourCollisionTable[i] |= 0x0020;
+
+    if((i & myP1Bit) && (i & myPFBit))    // P1-PF
+      ourCollisionTable[i] |= 0x0040;
+
+    if((i & myP1Bit) && (i & myBLBit))    // P1-BL
+      ourCollisionTable[i] |= 0x0080;
+
+    if((i & myM0Bit) && (i & myPFBit))    // M0-PF
+      ourCollisionTable[i] |= 0x0100;
+
+    if((i & myM0Bit) && (i & myBLBit))    // M0-BL
+      ourCollisionTable[i] |= 0x0200;
+
+    if((i & myM1Bit) && (i & myPFBit))    // M1-PF
+      ourCollisionTable[i] |= 0x0400;
+
+    if((i & myM1Bit) && (i & myBLBit))    // M1-BL
+      ourCollisionTable[i] |= 0x0800;
+
+    if((i & myBLBit) && (i & myPFBit))    // BL-PF
+      ourCollisionTable[i] |= 0x1000;
+
+    if((i & myP0Bit) && (i & myP1Bit))    // P0-P1
+      ourCollisionTable[i] |= 0x2000;
+
+    if((i & myM0Bit) && (i & myM1Bit))    // M0-M1
+      ourCollisionTable[i] |= 0x4000;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computeMissleMaskTable()
+{
+  Int32 x, size, number;
+
+  // Clear the missle table to start with
+  for(number = 0; number < 8; ++number)
+    for(size = 0; size < 4; ++size)
+      for(x = 0; x < 160; ++x)
+        ourMissleMaskTable[number][size][x] = false;
+
+  for(number = 0; number < 8; ++number)
+  {
+    for(size = 0; size < 4; ++size)
+    {
+      for(x = 0; x < 160 + 72; ++x)
+      {
+        // Only one copy of the missle
+        if((number == 0x00) || (number == 0x05) || (number == 0x07))
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+        // Two copies - close
+        else if(number == 0x01)
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+        // Two copies - medium
+        else if(number == 0x02)
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+        // Three copies - close
+        else if(number == 0x03)
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+        // Two copies - wide
+        else if(number == 0x04)
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+        // Three copies - medium
+        else if(number == 0x06)
+        {
+          if((x >= 0) && (x < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+          else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
+            ourMissleMaskTable[number][size][x % 160] = true;
+        }
+      }
+
+      // Copy data into wrap-around area
+      for(x = 0; x < 160; ++x)
+        ourMissleMaskTable[number][size][x + 160] = 
+          ourMissleMaskTable[number][size][x];
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computePlayerMaskTable()
+{
+  Int32 x, enable, mode;
+
+  // Set the player mask table to all zeros
+  for(enable = 0; enable < 2; ++enable)
+    for(mode = 0; mode < 8; ++mode)
+      for(x = 0; x < 160; ++x)
+        ourPlayerMaskTable[enable][mode][x] = 0x00;
+
+  // Now, compute the player mask table
+  for(enable = 0; enable < 2; ++enable)
+  {
+    for(mode = 0; mode < 8; ++mode)
+    {
+      for(x = 0; x < 160 + 72; ++x)
+      {
+        if(mode == 0x00)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+        }
+        else if(mode == 0x01)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+          else if(((x - 16) >= 0) && ((x - 16) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 16);
+        }
+        else if(mode == 0x02)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+          else if(((x - 32) >= 0) && ((x - 32) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 32);
+        }
+        else if(mode == 0x03)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+          else if(((x - 16) >= 0) && ((x - 16) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 16);
+          else if(((x - 32) >= 0) && ((x - 32) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 32);
+        }
+        else if(mode == 0x04)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+          else if(((x - 64) >= 0) && ((x - 64) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 64);
+        }
+        else if(mode == 0x05)
+        {
+          // For some reason in double size mode the player's output
+          // is delayed by one pixel thus we use > instead of >=
+          if((enable == 0) && (x > 0) && (x <= 16))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> ((x - 1)/2);
+        }
+        else if(mode == 0x06)
+        {
+          if((enable == 0) && (x >= 0) && (x < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> x;
+          else if(((x - 32) >= 0) && ((x - 32) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 32);
+          else if(((x - 64) >= 0) && ((x - 64) < 8))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> (x - 64);
+        }
+        else if(mode == 0x07)
+        {
+          // For some reason in quad size mode the player's output
+          // is delayed by one pixel thus we use > instead of >=
+          if((enable == 0) && (x > 0) && (x <= 32))
+            ourPlayerMaskTable[enable][mode][x % 160] = 0x80 >> ((x - 1)/4);
+        }
+      }
+  
+      // Copy data into wrap-around area
+      for(x = 0; x < 160; ++x)
+      {
+        ourPlayerMaskTable[enable][mode][x + 160] = 
+            ourPlayerMaskTable[enable][mode][x];
+      }
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computePlayerPositionResetWhenTable()
+{
+  uInt32 mode, oldx, newx;
+
+  // Loop through all player modes, all old player positions, and all new
+  // player positions and determine where the new position is located:
+  // 1 means the new position is within the display of an old copy of the
+  // player, -1 means the new position is within the delay portion of an
+  // old copy of the player, and 0 means it's neither of these two
+  for(mode = 0; mode < 8; ++mode)
+  {
+    for(oldx = 0; oldx < 160; ++oldx)
+    {
+      // Set everything to 0 for non-delay/non-display section
+      for(newx = 0; newx < 160; ++newx)
+      {
+        ourPlayerPositionResetWhenTable[mode][oldx][newx] = 0;
+      }
+
+      // Now, we'll set the entries for non-delay/non-display section
+      for(newx = 0; newx < 160 + 72 + 5; ++newx)
+      {
+        if(mode == 0x00)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x01)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x02)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x03)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x04)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x05)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 16)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x06)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+        else if(mode == 0x07)
+        {
+          if((newx >= oldx) && (newx < (oldx + 4)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+
+          if((newx >= oldx + 4) && (newx < (oldx + 4 + 32)))
+            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
+        }
+      }
+
+      // Let's do a sanity check on our table entries
+      uInt32 s1 = 0, s2 = 0;
+      for(newx = 0; newx < 160; ++newx)
+      {
+        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == -1)
+          ++s1;
+        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == 1)
+          ++s2;
+      }
+      assert((s1 % 4 == 0) && (s2 % 8 == 0));
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computePlayerReflectTable()
+{
+  for(uInt16 i = 0; i < 256; ++i)
+  {
+    uInt8 r = 0;
+
+    for(uInt16 t = 1; t <= 128; t *= 2)
+    {
+      r = (r << 1) | ((i & t) ? 0x01 : 0x00);
+    }
+
+    ourPlayerReflectTable[i] = r;
+  } 
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void computePlayfieldMaskTable()
+{
+  Int32 x;
+
+  // Compute playfield mask table for non-reflected mode
+  for(x = 0; x < 160; ++x)
+  {
+    if(x < 16)
+      ourPlayfieldTable[0][x] = 0x00001 << (x / 4);
+    else if(x < 48)
+      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 16) / 4);
+    else if(x < 80) 
+      ourPlayfieldTable[0][x] = 0x01000 << ((x - 48) / 4);
+    else if(x < 96) 
+      ourPlayfieldTable[0][x] = 0x00001 << ((x - 80) / 4);
+    else if(x < 128)
+      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 96) / 4);
+    else if(x < 160) 
+      ourPlayfieldTable[0][x] = 0x01000 << ((x - 128) / 4);
+  }
+
+  // Compute playfield mask table for reflected mode
+  for(x = 0; x < 160; ++x)
+  {
+    if(x < 16)
+      ourPlayfieldTable[1][x] = 0x00001 << (x / 4);
+    else if(x < 48)
+      ourPlayfieldTable[1][x] = 0x00800 >> ((x - 16) / 4);
+    else if(x < 80) 
+      ourPlayfieldTable[1][x] = 0x01000 << ((x - 48) / 4);
+    else if(x < 112) 
+      ourPlayfieldTable[1][x] = 0x80000 >> ((x - 80) / 4);
+    else if(x < 144) 
+      ourPlayfieldTable[1][x] = 0x00010 << ((x - 112) / 4);
+    else if(x < 160) 
+      ourPlayfieldTable[1][x] = 0x00008 >> ((x - 144) / 4);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void packRow(uInt32* packed, const uInt8* row, uInt8 value)
+{
+  // Pixel x is bit x % 32 of word x / 32
+  for(uInt32 x = 0; x < 320; ++x)
+    if(value ? (row[x] == value) : (row[x] != 0))
+      packed[x / 32] |= 1u << (x % 32);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void packMaskTables()
+{
+  for(uInt32 size = 0; size < 4; ++size)
+    packRow(ourPackedBallMaskTable[size], ourBallMaskTable[size], 0);
+
+  // The last number is the all clear mask of a disabled missle
+  for(uInt32 number = 0; number < 8; ++number)
+    for(uInt32 size = 0; size < 4; ++size)
+      packRow(ourPackedMissleMaskTable[number][size],
+              ourMissleMaskTable[number][size], 0);
+
+  // The player masks tell which graphics bit each pixel shows, so they're
+  // packed into the pixels showing any of the bits, and then a plane for
+  // each of the bits
+  for(uInt32 enable = 0; enable < 2; ++enable)
+  {
+    for(uInt32 mode = 0; mode < 8; ++mode)
+    {
+      packRow(ourPackedPlayerMaskTable[enable][mode][0],
+              ourPlayerMaskTable[enable][mode], 0);
+
+      for(uInt32 bit = 0; bit < 8; ++bit)
+        packRow(ourPackedPlayerMaskTable[enable][mode][bit + 1],
+                ourPlayerMaskTable[enable][mode], 1 << bit);
+    }
+  }
+
+  // Each playfield bit is 4 pixels wide
+  for(uInt32 i = 0; i < 256; ++i)
+    for(uInt32 bit = 0; bit < 8; ++bit)
+      if(i & (1 << bit))
+        ourPlayfieldExpandTable[i] |= 0x0fu << (bit * 4);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Writes the definition of a table of count entries of the given size in
+// bytes; only the entries of byte tables can be signed
+static void writeTable(FILE* out, const char* definition, const void* table,
+                       uInt32 size, uInt32 count, bool isSigned = false)
+{
+  fprintf(out, "\n// - - - - - - - - - - - - - - - - - - - - - - - - - - - -"
+               " - - - - - - - - - -\n");
+  fprintf(out, "%s = {", definition);
+
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    if(i % 16 == 0)
+      fprintf(out, "\n ");
+
+    if(isSigned)
+      fprintf(out, " %d,", ((const Int8*)table)[i]);
+    else if(size == 1)
+      fprintf(out, " 0x%02x,", ((const uInt8*)table)[i]);
+    else if(size == 2)
+      fprintf(out, " 0x%04x,", ((const uInt16*)table)[i]);
+    else
+      fprintf(out, " 0x%08x,", ((const uInt32*)table)[i]);
+  }
+
+  fprintf(out, "\n};\n");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  if(argc != 2)
+  {
+    fprintf(stderr, "usage: %s file.cpp\n", argv[0]);
+    return 1;
+  }
+
+  FILE* out = fopen(argv[1], "w");
+  if(!out)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // Compute all of the mask tables
+  computeBallMaskTable();
+  computeCollisionTable();
+  computeMissleMaskTable();
+  computePlayerMaskTable();
+  computePlayerPositionResetWhenTable();
+  computePlayerReflectTable();
+  computePlayfieldMaskTable();
+  packMaskTables();
+
+  fprintf(out, "// Generated by TIATablesGen, do not edit\n\n");
+  fprintf(out, "#include \"TIA.hxx\"\n");
+
+  writeTable(out, "const uInt32 TIA::ourBallMaskTable[4][11]",
+             ourPackedBallMaskTable, 4, 4 * MASK_ROW_WORDS);
+  writeTable(out, "const uInt16 TIA::ourCollisionTable[64]",
+             ourCollisionTable, 2, 64);
+  writeTable(out, "const uInt32 TIA::ourMissleMaskTable[9][4][11]",
+             ourPackedMissleMaskTable, 4, 9 * 4 * MASK_ROW_WORDS);
+  writeTable(out, "const uInt32 TIA::ourPlayerMaskTable[2][8][9][11]",
+             ourPackedPlayerMaskTable, 4, 2 * 8 * 9 * MASK_ROW_WORDS);
+  writeTable(out, "const Int8 TIA::ourPlayerPositionResetWhenTable[8][160][160]",
+             ourPlayerPositionResetWhenTable, 1,
+             sizeof(ourPlayerPositionResetWhenTable), true);
+  writeTable(out, "const uInt8 TIA::ourPlayerReflectTable[256]",
+             ourPlayerReflectTable, 1, 256);
+  writeTable(out, "const uInt32 TIA::ourPlayfieldTable[2][160]",
+             ourPlayfieldTable, 4, 2 * 160);
+  writeTable(out, "const uInt32 TIA::ourPlayfieldExpandTable[256]",
+             ourPlayfieldExpandTable, 4, 256);
+
+  if(fclose(out) != 0)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  return 0;
+}
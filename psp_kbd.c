@@ -192,7 +192,8 @@
     { ATARIC_AUTOFIRE, "C_AUTOFIRE" },
     { ATARIC_INCFIRE,  "C_INCFIRE" },
     { ATARIC_DECFIRE,  "C_DECFIRE" },
-    { ATARIC_SCREEN,   "C_SCREEN" }
+    { ATARIC_SCREEN,   "C_SCREEN" },
+    { ATARIC_REWIND,   "C_REWIND" }
   };
 
  static int loc_default_mapping[ KBD_ALL_BUTTONS ] = {
@@ -354,6 +355,11 @@ atari_key_event(int atari_idx, int key_press)
       atari_idx = atari_idx - JoystickZeroUp + JoystickOneUp;
     }
   }
+  if (atari_idx == ATARIC_REWIND) {
+    /* Rewind lasts as long as the key is held */
+    ATARI.atari_rewind_pressed = key_press;
+
+  } else
   if ((atari_idx >= ATARIC_FPS) &&
       (atari_idx <= ATARIC_SCREEN)) {
 
@@ -389,6 +395,8 @@ atari_kbd_reset()
   paddle_one_resistance  = PADDLE_MIDDLE_RES;
   paddle_zero_resistance = PADDLE_MIDDLE_RES;
 
+  ATARI.atari_rewind_pressed = 0;
+
   return 0;
 }
 
@@ -417,15 +425,15 @@ psp_kbd_reset_hotkeys(void)
   int key_id;
   for (index = 0; index < KBD_ALL_BUTTONS; index++) {
     key_id = loc_default_mapping[index];
-    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_SCREEN)) {
+    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_REWIND)) {
       psp_kbd_mapping[index] = key_id;
     }
     key_id = loc_default_mapping_L[index];
-    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_SCREEN)) {
+    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_REWIND)) {
       psp_kbd_mapping_L[index] = key_id;
     }
     key_id = loc_default_mapping_R[index];
-    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_SCREEN)) {
+    if ((key_id >= ATARIC_FPS) && (key_id <= ATARIC_REWIND)) {
       psp_kbd_mapping_R[index] = key_id;
     }
   }
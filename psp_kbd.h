@@ -66,6 +66,7 @@ extern "C" {
     ATARIC_INCFIRE,
     ATARIC_DECFIRE,
     ATARIC_SCREEN,
+    ATARIC_REWIND,
 
 # if 0
       BoosterGripZeroTrigger, 
@@ -43,28 +43,42 @@
 extern SDL_Surface *back_surface;
 
 # define MENU_SET_SOUND         0
-# define MENU_SET_VIEW_FPS      1
-# define MENU_SET_SPEED_LIMIT   2
-# define MENU_SET_SKIP_FPS      3
-# define MENU_SET_RENDER        4
-# define MENU_SET_FLICKER_MODE  5
-# define MENU_SET_CLOCK         6
-
-# define MENU_SET_LOAD          7
-# define MENU_SET_SAVE          8
-# define MENU_SET_RESET         9
-# define MENU_SET_BACK         10
+# define MENU_SET_SND_QUALITY   1
+# define MENU_SET_SND_WIDTH     2
+# define MENU_SET_VIEW_FPS      3
+# define MENU_SET_SPEED_LIMIT   4
+# define MENU_SET_SYNC_AUDIO    5
+# define MENU_SET_SKIP_FPS      6
+# define MENU_SET_RUN_AHEAD     7
+# define MENU_SET_REWIND        8
+# define MENU_SET_RENDER        9
+# define MENU_SET_VIDEO_THREAD  10
+# define MENU_SET_FLICKER_MODE  11
+# define MENU_SET_FLICKER_BLEND 12
+# define MENU_SET_CLOCK         13
+
+# define MENU_SET_LOAD          14
+# define MENU_SET_SAVE          15
+# define MENU_SET_RESET         16
+# define MENU_SET_BACK          17
 
 # define MAX_MENU_SET_ITEM (MENU_SET_BACK + 1)
 
   static menu_item_t menu_list[] =
   {
     { "Sound enable       :"},
+    { "Sound quality      :"},
+    { "Stereo width       :"},
     { "Display fps        :"},
     { "Speed limiter      :"},
+    { "Frame pacing       :"},
     { "Skip frame         :"},
+    { "Run ahead          :"},
+    { "Rewind             :"},
     { "Render mode        :"},
+    { "Video thread       :"},
     { "Flicker mode       :"},
+    { "Phosphor blend     :"},
     { "Clock frequency    :"},
     { "Load settings"        },
     { "Save settings"        },
@@ -75,12 +89,19 @@ extern SDL_Surface *back_surface;
   static int cur_menu_id = MENU_SET_LOAD;
 
   static int atari_snd_enable     = 0;
+  static int atari_snd_quality    = 0;
+  static int atari_snd_width      = 0;
   static int atari_render_mode    = 0;
+  static int atari_video_thread   = 0;
   static int atari_view_fps       = 0;
   static int atari_flicker_mode   = ATARI_FLICKER_NONE;
+  static int atari_flicker_blend  = ATARI_DEF_FLICKER_BLEND;
   static int atari_speed_limiter  = 60;
+  static int atari_sync_audio     = 0;
   static int psp_cpu_clock        = GP2X_DEF_EMU_CLOCK;
   static int atari_skip_fps       = 0;
+  static int atari_run_ahead      = 0;
+  static int atari_rewind         = 0;
 
 
 static void 
@@ -111,17 +132,48 @@ psp_display_screen_settings_menu(void)
       string_fill_with_space(buffer, 4);
       psp_sdl_back2_print(140, y, buffer, color);
     } else
+    if (menu_id == MENU_SET_SND_QUALITY) {
+      if (atari_snd_quality == ATARI_SND_QUALITY_HIGH) strcpy(buffer,"high");
+      else                                             strcpy(buffer,"fast");
+      string_fill_with_space(buffer, 5);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
+    if (menu_id == MENU_SET_SND_WIDTH) {
+      sprintf(buffer,"%d%%", atari_snd_width);
+      string_fill_with_space(buffer, 5);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
     if (menu_id == MENU_SET_VIEW_FPS) {
       if (atari_view_fps) strcpy(buffer,"yes");
       else                strcpy(buffer,"no ");
       string_fill_with_space(buffer, 4);
       psp_sdl_back2_print(140, y, buffer, color);
     } else
+    if (menu_id == MENU_SET_SYNC_AUDIO) {
+      if (atari_sync_audio == ATARI_SYNC_SOUND)    strcpy(buffer,"sound");
+      else
+      if (atari_sync_audio == ATARI_SYNC_RESAMPLE) strcpy(buffer,"resample");
+      else                                         strcpy(buffer,"timer");
+      string_fill_with_space(buffer, 9);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
     if (menu_id == MENU_SET_SKIP_FPS) {
       sprintf(buffer,"%d", atari_skip_fps);
       string_fill_with_space(buffer, 4);
       psp_sdl_back2_print(140, y, buffer, color);
     } else
+    if (menu_id == MENU_SET_REWIND) {
+      if (atari_rewind) strcpy(buffer,"yes");
+      else              strcpy(buffer,"no ");
+      string_fill_with_space(buffer, 4);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
+    if (menu_id == MENU_SET_RUN_AHEAD) {
+      if (atari_run_ahead == 0) strcpy(buffer,"no");
+      else sprintf(buffer, "%d frame%s", atari_run_ahead, (atari_run_ahead > 1) ? "s" : "");
+      string_fill_with_space(buffer, 10);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
     if (menu_id == MENU_SET_SPEED_LIMIT) {
       if (atari_speed_limiter == 0) strcpy(buffer,"no");
       else sprintf(buffer, "%d fps", atari_speed_limiter);
@@ -130,10 +182,19 @@ psp_display_screen_settings_menu(void)
     } else
     if (menu_id == MENU_SET_RENDER) {
 
-      /* if (atari_render_mode == ATARI_RENDER_NORMAL) */ strcpy(buffer, "normal");
+      if (atari_render_mode == ATARI_RENDER_HW_SHARP)  strcpy(buffer, "hw sharp");
+      else
+      if (atari_render_mode == ATARI_RENDER_HW_SMOOTH) strcpy(buffer, "hw smooth");
+      else                                             strcpy(buffer, "normal");
       string_fill_with_space(buffer, 13);
       psp_sdl_back2_print(140, y, buffer, color);
     } else
+    if (menu_id == MENU_SET_VIDEO_THREAD) {
+      if (atari_video_thread) strcpy(buffer,"yes");
+      else                    strcpy(buffer,"no ");
+      string_fill_with_space(buffer, 4);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
     if (menu_id == MENU_SET_FLICKER_MODE) {
 
       if (atari_flicker_mode == ATARI_FLICKER_NONE)     strcpy(buffer, "none");
@@ -146,6 +207,11 @@ psp_display_screen_settings_menu(void)
       string_fill_with_space(buffer, 13);
       psp_sdl_back2_print(140, y, buffer, color);
     } else
+    if (menu_id == MENU_SET_FLICKER_BLEND) {
+      sprintf(buffer,"%d%%", atari_flicker_blend);
+      string_fill_with_space(buffer, 5);
+      psp_sdl_back2_print(140, y, buffer, color);
+    } else
     if (menu_id == MENU_SET_CLOCK) {
       sprintf(buffer,"%d", psp_cpu_clock);
       string_fill_with_space(buffer, 4);
@@ -186,6 +252,30 @@ psp_settings_menu_flicker(int step)
   }
 }
 
+static void
+psp_settings_menu_flicker_blend(int step)
+{
+  if (step > 0) {
+    if (atari_flicker_blend < 100) atari_flicker_blend += 5;
+    if (atari_flicker_blend > 100) atari_flicker_blend  = 100;
+  } else {
+    if (atari_flicker_blend > 0) atari_flicker_blend -= 5;
+    if (atari_flicker_blend < 0) atari_flicker_blend  = 0;
+  }
+}
+
+static void
+psp_settings_menu_sync(int step)
+{
+  if (step > 0) {
+    if (atari_sync_audio < ATARI_LAST_SYNC) atari_sync_audio++;
+    else                                    atari_sync_audio = 0;
+  } else {
+    if (atari_sync_audio > 0) atari_sync_audio--;
+    else                      atari_sync_audio = ATARI_LAST_SYNC;
+  }
+}
+
 static void
 psp_settings_menu_clock(int step)
 {
@@ -208,6 +298,26 @@ psp_settings_menu_skip_fps(int step)
   }
 }
 
+static void
+psp_settings_menu_snd_width(int step)
+{
+  if (step > 0) {
+    if (atari_snd_width < 100) atari_snd_width += 10;
+  } else {
+    if (atari_snd_width > 0) atari_snd_width -= 10;
+  }
+}
+
+static void
+psp_settings_menu_run_ahead(int step)
+{
+  if (step > 0) {
+    if (atari_run_ahead < ATARI_MAX_RUN_AHEAD) atari_run_ahead++;
+  } else {
+    if (atari_run_ahead > 0) atari_run_ahead--;
+  }
+}
+
 static void
 psp_settings_menu_limiter(int step)
 {
@@ -224,11 +334,18 @@ static void
 psp_settings_menu_init(void)
 {
   atari_snd_enable     = ATARI.atari_snd_enable;
+  atari_snd_quality    = ATARI.atari_snd_quality;
+  atari_snd_width      = ATARI.atari_snd_width;
   atari_render_mode    = ATARI.atari_render_mode;
+  atari_video_thread   = ATARI.atari_video_thread;
   atari_flicker_mode   = ATARI.atari_flicker_mode;
+  atari_flicker_blend  = ATARI.atari_flicker_blend;
   atari_speed_limiter  = ATARI.atari_speed_limiter;
+  atari_sync_audio     = ATARI.atari_sync_audio;
   atari_view_fps       = ATARI.atari_view_fps;
   atari_skip_fps       = ATARI.psp_skip_max_frame;
+  atari_run_ahead      = ATARI.atari_run_ahead;
+  atari_rewind         = ATARI.atari_rewind;
   psp_cpu_clock        = ATARI.psp_cpu_clock;
 }
 
@@ -263,13 +380,20 @@ psp_settings_menu_validate(void)
 {
   /* Validate */
   ATARI.atari_snd_enable    = atari_snd_enable;
+  ATARI.atari_snd_quality   = atari_snd_quality;
+  ATARI.atari_snd_width     = atari_snd_width;
   ATARI.atari_render_mode   = atari_render_mode;
+  ATARI.atari_video_thread  = atari_video_thread;
   ATARI.atari_flicker_mode  = atari_flicker_mode;
+  ATARI.atari_flicker_blend = atari_flicker_blend;
   ATARI.atari_speed_limiter = atari_speed_limiter;
+  ATARI.atari_sync_audio    = atari_sync_audio;
   ATARI.atari_view_fps      = atari_view_fps;
   ATARI.psp_cpu_clock       = psp_cpu_clock;
   ATARI.psp_skip_max_frame  = atari_skip_fps;
   ATARI.psp_skip_cur_frame  = 0;
+  ATARI.atari_run_ahead     = atari_run_ahead;
+  ATARI.atari_rewind        = atari_rewind;
 
   myPowerSetClockFrequency(ATARI.psp_cpu_clock);
 }
@@ -397,15 +521,29 @@ psp_settings_menu(void)
       {
         case MENU_SET_SOUND      : atari_snd_enable = ! atari_snd_enable;
         break;              
+        case MENU_SET_SND_QUALITY : atari_snd_quality = ! atari_snd_quality;
+        break;              
+        case MENU_SET_SND_WIDTH  : psp_settings_menu_snd_width( step );
+        break;              
         case MENU_SET_SPEED_LIMIT : psp_settings_menu_limiter( step );
         break;              
+        case MENU_SET_SYNC_AUDIO : psp_settings_menu_sync( step );
+        break;              
         case MENU_SET_SKIP_FPS   : psp_settings_menu_skip_fps( step );
         break;              
+        case MENU_SET_RUN_AHEAD  : psp_settings_menu_run_ahead( step );
+        break;              
+        case MENU_SET_REWIND     : atari_rewind = ! atari_rewind;
+        break;              
         case MENU_SET_FLICKER_MODE : psp_settings_menu_flicker( step );
         break;              
+        case MENU_SET_FLICKER_BLEND : psp_settings_menu_flicker_blend( step );
+        break;              
         case MENU_SET_VIEW_FPS   : atari_view_fps = ! atari_view_fps;
         break;              
         case MENU_SET_RENDER     : psp_settings_menu_render( step );
+        break;
+        case MENU_SET_VIDEO_THREAD : atari_video_thread = ! atari_video_thread;
         break;              
         case MENU_SET_CLOCK      : psp_settings_menu_clock( step );
         break;
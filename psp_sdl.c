@@ -43,6 +43,25 @@
   SDL_Surface *thumb_surface;
   SDL_Surface *save_surface;
 
+  int psp_sdl_full_update = 1;
+
+  /* The video mode which is shown: back_surface, unless the game is
+     being shown through the hardware scaler */
+  SDL_Surface *screen_surface;
+
+  /* While scaled, the 320x240 pictures (menus, keyboard) are drawn
+     in there and only shown once the scaler is left */
+  SDL_Surface *shadow_surface = NULL;
+
+  static int  loc_scaled_mode = 0;
+  static int  loc_scaled_smooth = -1;
+  static int  loc_scaled_unavailable = 0;
+  static char loc_keep_aspect_ratio[16];
+
+  static SDL_mutex *loc_screen_mutex = NULL;
+  static Uint32     loc_main_thread  = 0;
+  static int        loc_screen_owned = 0;
+
 uint
 psp_sdl_rgb(uchar R, uchar G, uchar B)
 {
@@ -112,7 +131,12 @@ void
 psp_sdl_clear_screen(int color)
 {
   int x; int y;
-  ushort *vram = psp_sdl_get_vram_addr(0,0);
+  ushort *vram;
+
+  psp_sdl_acquire_screen();
+  vram = psp_sdl_get_vram_addr(0,0);
+
+  psp_sdl_full_update = 1;
   
   for (y = 0; y < PSP_SDL_SCREEN_HEIGHT; y++) {
     for (x = 0; x < PSP_SDL_SCREEN_WIDTH; x++) {
@@ -124,6 +148,11 @@ psp_sdl_clear_screen(int color)
 void
 psp_sdl_black_screen()
 {
+  psp_sdl_acquire_screen();
+  psp_sdl_leave_scaled();
+
+  psp_sdl_full_update = 1;
+
   SDL_FillRect(back_surface,NULL,SDL_MapRGB(back_surface->format,0x0,0x0,0x0));
   SDL_Flip(back_surface);
   SDL_FillRect(back_surface,NULL,SDL_MapRGB(back_surface->format,0x0,0x0,0x0));
@@ -354,6 +383,8 @@ psp_sdl_blit_background()
 {
   static int first = 1;
 
+  psp_sdl_acquire_screen();
+
   if (first && (background_surface == NULL)) {
     psp_sdl_load_background();
     first = 0;
@@ -381,6 +412,8 @@ psp_sdl_blit_thumb(int dst_x, int dst_y, SDL_Surface* thumb_surface)
 void
 psp_sdl_blit_splash()
 {
+  psp_sdl_acquire_screen();
+
   if (! splash_surface) {
     splash_surface = IMG_Load("./splash.png");
   }
@@ -390,6 +423,8 @@ psp_sdl_blit_splash()
 void
 psp_sdl_blit_help()
 {
+  psp_sdl_acquire_screen();
+
   if (! help_surface) {
     help_surface = IMG_Load("./help.png");
   }
@@ -433,9 +468,184 @@ psp_sdl_unlock(void)
 void
 psp_sdl_flip(void)
 {
+  /* Whatever was drawn at 320x240 can only be shown without the scaler */
+  psp_sdl_acquire_screen();
+  psp_sdl_leave_scaled();
+
   SDL_Flip(back_surface);
 }
 
+void
+psp_sdl_flip_rects(SDL_Rect* rects, int count)
+{
+  SDL_UpdateRects(screen_surface, count, rects);
+}
+
+void
+psp_sdl_flip_screen(void)
+{
+  SDL_Flip(screen_surface);
+}
+
+void
+psp_sdl_acquire_screen(void)
+{
+  /* The video thread draws the game itself */
+  if (! loc_screen_mutex || loc_screen_owned ||
+      (SDL_ThreadID() != loc_main_thread)) {
+    return;
+  }
+  SDL_mutexP(loc_screen_mutex);
+  loc_screen_owned = 1;
+}
+
+void
+psp_sdl_release_screen(void)
+{
+  if (loc_screen_owned) {
+    loc_screen_owned = 0;
+    SDL_mutexV(loc_screen_mutex);
+  }
+}
+
+void
+psp_sdl_present_begin(void)
+{
+  SDL_mutexP(loc_screen_mutex);
+}
+
+void
+psp_sdl_present_end(void)
+{
+  SDL_mutexV(loc_screen_mutex);
+}
+
+static int
+loc_write_sysfs(const char* filename, const char* value)
+{
+  FILE* fd = fopen(filename, "w");
+  if (! fd) return 0;
+  int error = (fputs(value, fd) < 0);
+  if (fclose(fd)) error = 1;
+  return ! error;
+}
+
+static int
+loc_read_sysfs(const char* filename, char* value, int size)
+{
+  FILE* fd = fopen(filename, "r");
+  if (! fd) return 0;
+  int error = (fgets(value, size, fd) == NULL);
+  fclose(fd);
+  return ! error;
+}
+
+SDL_Surface*
+psp_sdl_enter_scaled(int smooth)
+{
+  if (loc_scaled_unavailable) {
+    return NULL;
+  }
+
+  if (! loc_scaled_mode) {
+
+    /* Every pixel has to be stretched to two, so the aspect ratio
+       of the video mode can't be kept */
+    if (! loc_read_sysfs(PSP_SDL_KEEP_ASPECT_RATIO, loc_keep_aspect_ratio,
+                         sizeof(loc_keep_aspect_ratio)) ||
+        ! loc_write_sysfs(PSP_SDL_KEEP_ASPECT_RATIO, "0")) {
+      loc_scaled_unavailable = 1;
+      return NULL;
+    }
+
+    if (! shadow_surface) {
+      shadow_surface = SDL_CreateRGBSurface(SDL_SWSURFACE,
+                            PSP_SDL_SCREEN_WIDTH, PSP_SDL_SCREEN_HEIGHT,
+                            back_surface->format->BitsPerPixel,
+                            back_surface->format->Rmask,
+                            back_surface->format->Gmask,
+                            back_surface->format->Bmask, 0);
+    }
+
+    SDL_Surface* scaled = NULL;
+    if (shadow_surface) {
+      SDL_BlitSurface(back_surface, NULL, shadow_surface, NULL);
+      scaled = SDL_SetVideoMode(PSP_SDL_SCALED_WIDTH, PSP_SDL_SCREEN_HEIGHT, 16,
+                                SDL_SWSURFACE);
+    }
+
+    if (! scaled || (scaled->w != PSP_SDL_SCALED_WIDTH) ||
+        (scaled->format->BitsPerPixel != 16)) {
+      /* Back to the mode we had, and never try again */
+      loc_write_sysfs(PSP_SDL_KEEP_ASPECT_RATIO, loc_keep_aspect_ratio);
+      if (shadow_surface) {
+        back_surface = SDL_SetVideoMode(PSP_SDL_SCREEN_WIDTH, PSP_SDL_SCREEN_HEIGHT, 16,
+                                        SDL_SWSURFACE);
+        if (! back_surface) {
+          psp_sdl_exit(1);
+        }
+        screen_surface = back_surface;
+        danzeff_set_screen(back_surface);
+        SDL_BlitSurface(shadow_surface, NULL, back_surface, NULL);
+        psp_sdl_full_update = 1;
+      }
+      loc_scaled_unavailable = 1;
+      return NULL;
+    }
+
+    screen_surface = scaled;
+    back_surface   = shadow_surface;
+    danzeff_set_screen(back_surface);
+
+    loc_scaled_mode = 1;
+    loc_scaled_smooth = -1;
+    psp_sdl_full_update = 1;
+  }
+
+  /* The IPU always filters, the sharpest setting is the closest
+     to nearest neighbour */
+  if (smooth != loc_scaled_smooth) {
+    loc_write_sysfs(PSP_SDL_SHARPNESS_UPSCALING, smooth ? "0" : "32");
+    loc_scaled_smooth = smooth;
+  }
+
+  return screen_surface;
+}
+
+void
+psp_sdl_leave_scaled(void)
+{
+  if (! loc_scaled_mode) {
+    return;
+  }
+  loc_scaled_mode = 0;
+
+  loc_write_sysfs(PSP_SDL_KEEP_ASPECT_RATIO, loc_keep_aspect_ratio);
+
+  back_surface = SDL_SetVideoMode(PSP_SDL_SCREEN_WIDTH, PSP_SDL_SCREEN_HEIGHT, 16,
+                                  SDL_SWSURFACE);
+  if (! back_surface) {
+    psp_sdl_exit(1);
+  }
+  screen_surface = back_surface;
+  danzeff_set_screen(back_surface);
+
+  SDL_BlitSurface(shadow_surface, NULL, back_surface, NULL);
+  psp_sdl_full_update = 1;
+}
+
+int
+psp_sdl_is_scaled(void)
+{
+  return loc_scaled_mode;
+}
+
+int
+psp_sdl_can_scale(void)
+{
+  return ! loc_scaled_unavailable;
+}
+
 #define  systemRedShift      (back_surface->format->Rshift)
 #define  systemGreenShift    (back_surface->format->Gshift)
 #define  systemBlueShift     (back_surface->format->Bshift)
@@ -675,6 +885,9 @@ psp_sdl_init(void)
     return 0;
   }
 
+  loc_screen_mutex = SDL_CreateMutex();
+  loc_main_thread  = SDL_ThreadID();
+
   psp_sdl_select_font_6x10();
 
   back_surface=SDL_SetVideoMode(PSP_SDL_SCREEN_WIDTH,PSP_SDL_SCREEN_HEIGHT, 16 , 
@@ -683,6 +896,7 @@ psp_sdl_init(void)
   if ( !back_surface) {
     return 0;
   }
+  screen_surface = back_surface;
 
   blit_surface = SDL_CreateRGBSurface(SDL_SWSURFACE, 
      ATARI_WIDTH, ATARI_HEIGHT,
@@ -722,6 +936,11 @@ psp_sdl_init(void)
 void
 psp_sdl_exit(int status)
 {
+  if (loc_scaled_mode) {
+    loc_scaled_mode = 0;
+    loc_write_sysfs(PSP_SDL_KEEP_ASPECT_RATIO, loc_keep_aspect_ratio);
+  }
+
   SDL_CloseAudio();
   SDL_Quit();
   sleep(1);
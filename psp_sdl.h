@@ -30,6 +30,13 @@ extern "C" {
 # define PSP_SDL_SCREEN_WIDTH    320
 # define PSP_SDL_SCREEN_HEIGHT   240
 
+/* The game is shown at its own width through the hardware scaler, which
+   stretches it to the whole screen */
+# define PSP_SDL_SCALED_WIDTH    160
+
+# define PSP_SDL_KEEP_ASPECT_RATIO   "/sys/devices/platform/jz-lcd.0/keep_aspect_ratio"
+# define PSP_SDL_SHARPNESS_UPSCALING "/sys/devices/platform/jz-lcd.0/sharpness_upscaling"
+
   typedef unsigned char   uchar;
   typedef unsigned int    uint;
   typedef unsigned short  ushort;
@@ -53,6 +60,29 @@ extern "C" {
   extern void psp_sdl_put_char(int x, int y, int color, int bgcolor, uchar c, int drawfg, int drawbg);
   extern void psp_sdl_fill_print(int x,int y,const char *str, int color, int bgcolor);
   extern void psp_sdl_flip(void);
+  extern void psp_sdl_flip_rects(SDL_Rect* rects, int count);
+
+  /* Switches to the video mode stretched by the hardware scaler, nearest
+     or smooth; answers its surface, or NULL if there is no scaler */
+  extern SDL_Surface* psp_sdl_enter_scaled(int smooth);
+  extern void psp_sdl_leave_scaled(void);
+  extern int psp_sdl_is_scaled(void);
+  extern int psp_sdl_can_scale(void);
+
+  /* Flips the video mode shown, scaled or not, without changing it */
+  extern void psp_sdl_flip_screen(void);
+
+  /* While the video thread presents the game, the screen is its own; the
+     main thread owns it before drawing anything else (menus, keyboard)
+     and hands it back with the next game frame */
+  extern void psp_sdl_acquire_screen(void);
+  extern void psp_sdl_release_screen(void);
+  extern void psp_sdl_present_begin(void);
+  extern void psp_sdl_present_end(void);
+
+  /* Set when the whole screen was drawn over, so that the emulator
+     redraws and flips all of it */
+  extern int psp_sdl_full_update;
 
   extern void psp_sdl_lock(void);
   extern void psp_sdl_unlock(void);